@@ -37,6 +37,7 @@ GENERIC_FEATURES = \
     SPACE_CADET \
     SWAP_HANDS \
     TAP_DANCE \
+    TASK_PROFILER \
     VELOCIKEY \
     WPM \
     DYNAMIC_TAPPING_TERM \
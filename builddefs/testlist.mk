@@ -1,12 +1,18 @@
 TEST_LIST = $(sort $(patsubst %/test.mk,%, $(shell find $(ROOT_DIR)tests -type f -name test.mk)))
 FULL_TESTS := $(notdir $(TEST_LIST))
 
+include $(QUANTUM_PATH)/action_layer/tests/testlist.mk
 include $(QUANTUM_PATH)/debounce/tests/testlist.mk
+include $(QUANTUM_PATH)/dynamic_keymap/tests/testlist.mk
 include $(QUANTUM_PATH)/encoder/tests/testlist.mk
+include $(QUANTUM_PATH)/matrix/tests/testlist.mk
 include $(QUANTUM_PATH)/os_detection/tests/testlist.mk
 include $(QUANTUM_PATH)/sequencer/tests/testlist.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/testlist.mk
+include $(DRIVER_PATH)/oled/tests/testlist.mk
 include $(PLATFORM_PATH)/test/testlist.mk
+include $(PLATFORM_PATH)/avr/drivers/tests/testlist.mk
+include $(PROTOCOL_PATH)/vusb/tests/testlist.mk
 
 define VALIDATE_TEST_LIST
     ifneq ($1,)
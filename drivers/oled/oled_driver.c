@@ -148,6 +148,7 @@ bool            oled_active         = false;
 bool            oled_scrolling      = false;
 bool            oled_inverted       = false;
 uint8_t         oled_brightness     = OLED_BRIGHTNESS;
+uint16_t        oled_blocks_sent    = 0;
 oled_rotation_t oled_rotation       = 0;
 uint8_t         oled_rotation_width = 0;
 uint8_t         oled_scroll_speed   = 0; // this holds the speed after being remapped to ssd1306 internal values
@@ -276,6 +277,54 @@ __attribute__((weak)) void oled_driver_init(void) {
 #endif
 }
 
+#if defined(OLED_TRANSPORT_I2C) && defined(I2C_ASYNC_ENABLE)
+// oled_render() queues a block and returns while the TWI interrupt shifts it
+// out, the next call checks on it. The block's bytes are read from the buffer
+// as they go out, a change in the meantime dirties the block again.
+static i2c_async_transfer_t oled_render_cmd_transfer;
+static i2c_async_transfer_t oled_render_data_transfer;
+static uint8_t              oled_render_cmd[8];
+static int8_t               oled_render_block = -1;
+
+static void oled_render_wait(const i2c_async_transfer_t *transfer) {
+    while (i2c_async_status(transfer) == I2C_STATUS_PENDING) {
+    }
+}
+
+// true while the last queued block is still on the bus, a failed block is dirtied again
+static bool oled_render_busy(void) {
+    if (oled_render_block < 0) {
+        return false;
+    }
+    i2c_status_t cmd_status  = i2c_async_status(&oled_render_cmd_transfer);
+    i2c_status_t data_status = i2c_async_status(&oled_render_data_transfer);
+    if (cmd_status == I2C_STATUS_PENDING || data_status == I2C_STATUS_PENDING) {
+        return true;
+    }
+    if (cmd_status != I2C_STATUS_SUCCESS || data_status != I2C_STATUS_SUCCESS) {
+        oled_dirty |= (OLED_BLOCK_TYPE)1 << oled_render_block;
+    }
+    oled_render_block = -1;
+    return false;
+}
+
+// Only an SH1106/SH1107 turned by 90 degrees sends more than one command per
+// block, the later ones wait for the previous transfer
+static bool oled_render_send_cmd(const uint8_t *data, uint16_t size) {
+    oled_render_wait(&oled_render_cmd_transfer);
+    memcpy(oled_render_cmd, data, size);
+    return i2c_transmit_async(&oled_render_cmd_transfer, (OLED_DISPLAY_ADDRESS << 1), oled_render_cmd, size, NULL) == I2C_STATUS_PENDING;
+}
+
+static bool oled_render_send_data(const uint8_t *data, uint16_t size) {
+    oled_render_wait(&oled_render_data_transfer);
+    return i2c_writeReg_async(&oled_render_data_transfer, (OLED_DISPLAY_ADDRESS << 1), I2C_DATA, data, size, NULL) == I2C_STATUS_PENDING;
+}
+#else
+#    define oled_render_send_cmd oled_send_cmd
+#    define oled_render_send_data oled_send_data
+#endif
+
 // Flips the rendering bits for a character at the current cursor position
 static void InvertCharacter(uint8_t *cursor) {
     const uint8_t *end = cursor + OLED_FONT_WIDTH;
@@ -449,6 +498,12 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
 }
 
 void oled_render(void) {
+#if defined(OLED_TRANSPORT_I2C) && defined(I2C_ASYNC_ENABLE)
+    if (oled_render_busy()) {
+        return;
+    }
+#endif
+
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
     if (!oled_dirty || !oled_initialized || oled_scrolling) {
@@ -479,14 +534,14 @@ void oled_render(void) {
         }
 
         // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        if (!oled_render_send_cmd(display_start, ARRAY_SIZE(display_start))) {
             print("oled_render offset command failed\n");
             return;
         }
 
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            if (!oled_render_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
                 print("oled_render data failed\n");
                 return;
             }
@@ -503,7 +558,7 @@ void oled_render(void) {
 
 #if OLED_IC_HAS_HORIZONTAL_MODE
             // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            if (!oled_render_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
                 print("oled_render90 data failed\n");
                 return;
             }
@@ -515,13 +570,13 @@ void oled_render(void) {
                 // Send column & page position for all pages except the first one
                 if (i > 0) {
                     display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                    if (!oled_render_send_cmd(display_start, ARRAY_SIZE(display_start))) {
                         print("oled_render offset command failed\n");
                         return;
                     }
                 }
                 // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                if (!oled_render_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
                     print("oled_render90 data failed\n");
                     return;
                 }
@@ -531,6 +586,12 @@ void oled_render(void) {
 
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        oled_blocks_sent++;
+#if defined(OLED_TRANSPORT_I2C) && defined(I2C_ASYNC_ENABLE)
+        // the block's buffers stay in use until it is on the display
+        oled_render_block = update_start;
+        break;
+#endif
     }
 }
 
@@ -708,6 +769,178 @@ void oled_write_pixel(uint8_t x, uint8_t y, bool on) {
     }
 }
 
+// Applies a pixel mask to a single buffer byte, returns the dirty block bit if the byte changed
+static inline OLED_BLOCK_TYPE oled_apply_mask(uint16_t index, uint8_t mask, bool on) {
+    uint8_t data = on ? (oled_buffer[index] | mask) : (oled_buffer[index] & ~mask);
+    if (oled_buffer[index] == data) {
+        return 0;
+    }
+    oled_buffer[index] = data;
+    return ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+}
+
+static inline uint8_t oled_rotation_height(void) {
+    return OLED_MATRIX_SIZE / oled_rotation_width * 8;
+}
+
+void oled_fill_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool on) {
+    uint8_t max_x = oled_rotation_width;
+    uint8_t max_y = oled_rotation_height();
+    if (x >= max_x || y >= max_y || !width || !height) {
+        return;
+    }
+    if (width > max_x - x) width = max_x - x;
+    if (height > max_y - y) height = max_y - y;
+
+    OLED_BLOCK_TYPE dirty = 0;
+    uint8_t         y_end = y + height; // exclusive
+    // Walk page by page, each column of a page is covered by a single masked byte write
+    for (uint8_t page = y / 8; page * 8 < y_end; page++) {
+        uint8_t mask = 0xFF;
+        if (page == y / 8) mask &= (uint8_t)(0xFF << (y % 8));
+        if (page == (y_end - 1) / 8) mask &= (uint8_t)(0xFF >> (7 - ((y_end - 1) % 8)));
+
+        uint16_t index = x + page * oled_rotation_width;
+        uint16_t end   = index + width;
+        for (; index < end; index++) {
+            dirty |= oled_apply_mask(index, mask, on);
+        }
+    }
+    oled_dirty |= dirty;
+}
+
+void oled_draw_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool on) {
+    if (!width || !height) {
+        return;
+    }
+    oled_fill_rect(x, y, width, 1, on);
+    oled_fill_rect(x, y + height - 1, width, 1, on);
+    if (height > 2) {
+        oled_fill_rect(x, y + 1, 1, height - 2, on);
+        oled_fill_rect(x + width - 1, y + 1, 1, height - 2, on);
+    }
+}
+
+void oled_draw_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool on) {
+    // Axis aligned lines are rectangles one pixel wide
+    if (x0 == x1 || y0 == y1) {
+        uint8_t x = x0 < x1 ? x0 : x1;
+        uint8_t y = y0 < y1 ? y0 : y1;
+        oled_fill_rect(x, y, (x0 < x1 ? x1 - x0 : x0 - x1) + 1, (y0 < y1 ? y1 - y0 : y0 - y1) + 1, on);
+        return;
+    }
+
+    int16_t dx  = x0 < x1 ? x1 - x0 : x0 - x1;
+    int16_t dy  = y0 < y1 ? y0 - y1 : y1 - y0; // negative
+    int8_t  sx  = x0 < x1 ? 1 : -1;
+    int8_t  sy  = y0 < y1 ? 1 : -1;
+    int16_t err = dx + dy;
+
+    // The screen is convex, so a line with both ends on screen never leaves it.
+    // Anything else is rare enough to go through the bounds checked per-pixel path.
+    uint8_t max_y = oled_rotation_height();
+    if (x0 >= oled_rotation_width || x1 >= oled_rotation_width || y0 >= max_y || y1 >= max_y) {
+        for (;;) {
+            oled_write_pixel(x0, y0, on);
+            if (x0 == x1 && y0 == y1) break;
+            int16_t e2 = 2 * err;
+            if (e2 >= dy) {
+                err += dy;
+                x0 += sx;
+            }
+            if (e2 <= dx) {
+                err += dx;
+                y0 += sy;
+            }
+        }
+        return;
+    }
+
+    // Bresenham walking the buffer directly: a step in x moves one byte, a step
+    // in y moves one bit and only crosses to the next page every 8 pixels.
+    // Pixels falling into the same byte are merged into a single masked write.
+    OLED_BLOCK_TYPE dirty = 0;
+    uint16_t        index = x0 + (y0 / 8) * oled_rotation_width;
+    uint8_t         bit   = 1 << (y0 % 8);
+    uint8_t         mask  = 0;
+    for (;;) {
+        mask |= bit;
+        if (x0 == x1 && y0 == y1) break;
+        int16_t  e2         = 2 * err;
+        uint16_t next_index = index;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+            next_index += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+            if (sy > 0) {
+                bit <<= 1;
+                if (!bit) {
+                    bit = 0x01;
+                    next_index += oled_rotation_width;
+                }
+            } else {
+                bit >>= 1;
+                if (!bit) {
+                    bit = 0x80;
+                    next_index -= oled_rotation_width;
+                }
+            }
+        }
+        if (next_index != index) {
+            dirty |= oled_apply_mask(index, mask, on);
+            index = next_index;
+            mask  = 0;
+        }
+    }
+    dirty |= oled_apply_mask(index, mask, on);
+    oled_dirty |= dirty;
+}
+
+void oled_write_compressed(oled_byte_source_t read_byte) {
+    uint8_t  width       = read_byte();
+    uint8_t  pages       = read_byte();
+    uint16_t start_index = oled_cursor - &oled_buffer[0];
+    uint8_t  start_col   = start_index % oled_rotation_width;
+
+    OLED_BLOCK_TYPE dirty  = 0;
+    uint8_t         remain = 0;
+    bool            repeat = false;
+    uint8_t         c      = 0;
+    for (uint8_t page = 0; page < pages; page++) {
+        uint16_t index = start_index + page * oled_rotation_width;
+        for (uint8_t col = 0; col < width; col++, index++) {
+            // Same RLE encoding as Quantum Painter, see qmk.painter.compress_bytes_qmk_rle
+            if (!remain) {
+                uint8_t marker = read_byte();
+                if (marker >= 128) {
+                    repeat = false;
+                    remain = marker - 127;
+                } else {
+                    repeat = true;
+                    remain = marker;
+                    c      = read_byte();
+                }
+            }
+            if (!repeat) {
+                c = read_byte();
+            }
+            remain--;
+
+            // Parts of the image off the screen are still consumed from the stream
+            if (start_col + col >= oled_rotation_width || index >= OLED_MATRIX_SIZE || oled_buffer[index] == c) {
+                continue;
+            }
+            oled_buffer[index] = c;
+            dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+        }
+    }
+    oled_dirty |= dirty;
+}
+
 #if defined(__AVR__)
 void oled_write_P(const char *data, bool invert) {
     uint8_t c = pgm_read_byte(data);
@@ -782,6 +1015,10 @@ bool oled_off(void) {
     return !oled_active;
 }
 
+uint16_t oled_get_blocks_sent(void) {
+    return oled_blocks_sent;
+}
+
 bool is_oled_on(void) {
     return oled_active;
 }
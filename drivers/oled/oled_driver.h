@@ -401,6 +401,25 @@ void oled_write_raw_byte(const char data, uint16_t index);
 // Coordinates start at top-left and go right and down for positive x and y
 void oled_write_pixel(uint8_t x, uint8_t y, bool on);
 
+// Draws a line between two pixels (inclusive), sets the pixels on or off
+// Walks the buffer a byte at a time and only dirties the blocks it changed
+void oled_draw_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool on);
+
+// Draws the outline of a rectangle, top-left corner at x, y
+void oled_draw_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool on);
+
+// Sets or clears every pixel of a rectangle, top-left corner at x, y
+// Clipped to the screen, writes one masked byte per column per page
+void oled_fill_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool on);
+
+// Pulls the next byte of a compressed image from its storage
+typedef uint8_t (*oled_byte_source_t)(void);
+
+// Decodes an RLE compressed image produced by `qmk painter-convert-oled` at the current cursor position
+// Bytes are pulled from read_byte as they are needed, so the image never has to fit in RAM
+// Parts of the image falling off the screen are clipped
+void oled_write_compressed(oled_byte_source_t read_byte);
+
 #if defined(__AVR__)
 // Writes a PROGMEM string to the buffer at current cursor position
 // Advances the cursor while writing, inverts the pixels if true
@@ -433,6 +452,10 @@ bool oled_off(void);
 // not
 bool is_oled_on(void);
 
+// Returns the number of blocks sent to the display so far, wraps around.
+// The difference between two calls tells how much display traffic there was.
+uint16_t oled_get_blocks_sent(void);
+
 // Sets the brightness of the display
 uint8_t oled_set_brightness(uint8_t level);
 
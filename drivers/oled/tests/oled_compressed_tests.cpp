@@ -0,0 +1,86 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "oled_driver.h"
+#include "oled_test_images.h"
+
+extern uint8_t         oled_buffer[OLED_MATRIX_SIZE];
+extern OLED_BLOCK_TYPE oled_dirty;
+}
+
+// The images were encoded by qmk.painter_oled, which checks that this header is up to date
+static const uint8_t* image;
+static size_t         image_pos;
+
+static uint8_t read_image_byte(void) {
+    return image[image_pos++];
+}
+
+class OledCompressedTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        oled_init(OLED_ROTATION_0);
+        oled_clear();
+        oled_dirty = 0;
+    }
+
+    void write_image(const uint8_t* encoded, uint8_t col, uint8_t line) {
+        image     = encoded;
+        image_pos = 0;
+        oled_set_cursor(col, line);
+        oled_write_compressed(read_image_byte);
+    }
+
+    // What the screen holds after drawing `raw` with its top left corner at x, page
+    std::vector<uint8_t> expected_screen(const uint8_t* raw, uint8_t width, uint8_t pages, uint8_t x, uint8_t page) {
+        std::vector<uint8_t> screen(OLED_MATRIX_SIZE, 0);
+        for (uint8_t p = 0; p < pages && page + p < OLED_DISPLAY_HEIGHT / 8; p++) {
+            for (uint8_t col = 0; col < width && x + col < OLED_DISPLAY_WIDTH; col++) {
+                screen[(page + p) * OLED_DISPLAY_WIDTH + x + col] = raw[p * width + col];
+            }
+        }
+        return screen;
+    }
+
+    std::vector<uint8_t> screen() {
+        return std::vector<uint8_t>(oled_buffer, oled_buffer + OLED_MATRIX_SIZE);
+    }
+};
+
+TEST_F(OledCompressedTest, FullScreen) {
+    write_image(full_encoded, 0, 0);
+    EXPECT_EQ(image_pos, sizeof(full_encoded));
+    EXPECT_EQ(screen(), expected_screen(full_raw, 128, 4, 0, 0));
+}
+
+TEST_F(OledCompressedTest, PartialPageAtCursor) {
+    write_image(partial_encoded, 2, 1);
+    EXPECT_EQ(image_pos, sizeof(partial_encoded));
+    EXPECT_EQ(screen(), expected_screen(partial_raw, 40, 2, 2 * OLED_FONT_WIDTH, 1));
+    // columns 12 to 51 of pages 1 and 2, in 32 byte blocks
+    EXPECT_EQ(oled_dirty, 0x0330);
+}
+
+TEST_F(OledCompressedTest, ClippedAtRightEdge) {
+    // columns past the right edge are read but must not wrap onto the next page
+    write_image(partial_encoded, 17, 2);
+    EXPECT_EQ(image_pos, sizeof(partial_encoded));
+    EXPECT_EQ(screen(), expected_screen(partial_raw, 40, 2, 17 * OLED_FONT_WIDTH, 2));
+}
+
+TEST_F(OledCompressedTest, ClippedAtBottom) {
+    write_image(partial_encoded, 0, 3);
+    EXPECT_EQ(image_pos, sizeof(partial_encoded));
+    EXPECT_EQ(screen(), expected_screen(partial_raw, 40, 2, 0, 3));
+}
+
+TEST_F(OledCompressedTest, UnchangedImageDirtiesNothing) {
+    write_image(full_encoded, 0, 0);
+    oled_dirty = 0;
+    write_image(full_encoded, 0, 0);
+    EXPECT_EQ(oled_dirty, 0);
+}
@@ -0,0 +1,77 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated from sample_image() in lib/python/qmk/tests/test_painter_oled.py, do not edit
+
+#pragma once
+
+#include <stdint.h>
+
+static const uint8_t full_encoded[] = {
+    0x80, 0x04, 0x02, 0x00, 0x3F, 0xFC, 0x20, 0x00, 0x04, 0x80, 0x04, 0x40, 0x04, 0x20, 0x04, 0x10,
+    0x04, 0x08, 0x04, 0x04, 0x04, 0x02, 0x03, 0x01, 0x02, 0x00, 0x3F, 0xFF, 0x03, 0x80, 0x04, 0x40,
+    0x04, 0x20, 0x04, 0x10, 0x04, 0x08, 0x05, 0x04, 0x04, 0x02, 0x04, 0x01, 0x21, 0x00, 0x1D, 0x01,
+    0x04, 0x81, 0x04, 0x41, 0x05, 0x21, 0x04, 0x11, 0x04, 0x09, 0x04, 0x05, 0x04, 0x03, 0x05, 0x01,
+    0x3F, 0x00, 0x03, 0x80, 0x80, 0xC0, 0x02, 0x40, 0x80, 0xC0, 0x02, 0x20, 0x83, 0xA0, 0x20, 0x10,
+    0x90, 0x02, 0x10, 0x80, 0x88, 0x02, 0x08, 0x80, 0x88, 0x02, 0x04, 0x83, 0x84, 0x04, 0x02, 0x82,
+    0x02, 0x02, 0x80, 0x81, 0x02, 0x01, 0x80, 0x81, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80,
+    0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80,
+    0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80,
+    0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80,
+    0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80,
+    0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80,
+    0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80,
+    0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x80, 0x80,
+    0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x81, 0x80, 0x00,
+};
+
+static const uint8_t full_raw[] = {
+    0x00, 0x00, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC,
+    0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC,
+    0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC,
+    0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC,
+    0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x80, 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20, 0x20, 0x20, 0x10, 0x10, 0x10,
+    0x10, 0x08, 0x08, 0x08, 0x08, 0x04, 0x04, 0x04, 0x04, 0x02, 0x02, 0x02, 0x02, 0x01, 0x01, 0x01,
+    0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20, 0x20, 0x20, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x08, 0x08, 0x04, 0x04, 0x04, 0x04, 0x04, 0x02, 0x02, 0x02, 0x02, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x81,
+    0x81, 0x81, 0x81, 0x41, 0x41, 0x41, 0x41, 0x21, 0x21, 0x21, 0x21, 0x21, 0x11, 0x11, 0x11, 0x11,
+    0x09, 0x09, 0x09, 0x09, 0x05, 0x05, 0x05, 0x05, 0x03, 0x03, 0x03, 0x03, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x80, 0x80, 0xC0, 0x40, 0x40, 0xC0, 0x20, 0x20, 0xA0, 0x20, 0x10, 0x90, 0x10, 0x10, 0x88,
+    0x08, 0x08, 0x88, 0x04, 0x04, 0x84, 0x04, 0x02, 0x82, 0x02, 0x02, 0x81, 0x01, 0x01, 0x81, 0x00,
+    0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00,
+    0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80,
+    0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00,
+    0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00,
+    0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80,
+    0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00,
+};
+
+static const uint8_t partial_encoded[] = {
+    0x28, 0x02, 0x02, 0x00, 0x0D, 0x7C, 0x03, 0xFC, 0x03, 0x7C, 0x80, 0x40, 0x03, 0x20, 0x03, 0x10,
+    0x03, 0x08, 0x04, 0x04, 0x03, 0x02, 0x02, 0x01, 0x02, 0x10, 0x84, 0x08, 0x18, 0x08, 0x04, 0x14,
+    0x02, 0x04, 0x80, 0x12, 0x02, 0x02, 0x80, 0x11, 0x02, 0x01, 0x80, 0x10, 0x02, 0x00, 0x80, 0x10,
+    0x02, 0x00, 0x80, 0x10, 0x02, 0x00, 0x80, 0x10, 0x02, 0x00, 0x80, 0x10, 0x02, 0x00, 0x80, 0x10,
+    0x02, 0x00, 0x80, 0x10, 0x02, 0x00, 0x80, 0x10, 0x02, 0x00, 0x80, 0x10,
+};
+
+static const uint8_t partial_raw[] = {
+    0x00, 0x00, 0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0xFC,
+    0xFC, 0xFC, 0x7C, 0x7C, 0x7C, 0x40, 0x20, 0x20, 0x20, 0x10, 0x10, 0x10, 0x08, 0x08, 0x08, 0x04,
+    0x04, 0x04, 0x04, 0x02, 0x02, 0x02, 0x01, 0x01, 0x10, 0x10, 0x08, 0x18, 0x08, 0x04, 0x14, 0x04,
+    0x04, 0x12, 0x02, 0x02, 0x11, 0x01, 0x01, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10,
+};
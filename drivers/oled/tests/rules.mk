@@ -0,0 +1,10 @@
+oled_compressed_DEFS := -DOLED_TRANSPORT_I2C
+oled_compressed_INC := \
+	$(DRIVER_PATH)/oled/tests \
+	$(DRIVER_PATH)/oled
+
+oled_compressed_SRC := \
+	$(DRIVER_PATH)/oled/tests/mock_i2c.c \
+	$(DRIVER_PATH)/oled/tests/oled_compressed_tests.cpp \
+	$(DRIVER_PATH)/oled/oled_driver.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -34,6 +34,10 @@
 
 /* COL2ROW, ROW2COL*/
 #define DIODE_DIRECTION COL2ROW
+// the 16 columns sit on ports B, A, C and D, read each port once per row.
+// not benchmarked on this board yet: compare the "matrix" line of
+// TASK_PROFILER_ENABLE = yes with and without it before turning it on.
+// #define MATRIX_COL_PORT_READ
 
 
 /* Debounce reduces chatter (unintended double-presses) - set 0 if debouncing is not needed */
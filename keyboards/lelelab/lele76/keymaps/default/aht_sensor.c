@@ -1,52 +1,195 @@
 #include "aht_sensor.h"
 #include "quantum.h"
 #include "i2c_master.h"
+#include "deferred_exec.h"
 
 #define AHT21_ADDR 0x38
 
+// the sensor needs 100ms after power up before it takes commands
+#define AHT21_POWER_UP_TIME 100
+// a conversion takes 80ms, poll again every 10ms if it is still busy after that
+#define AHT21_MEASURE_TIME 80
+#define AHT21_BUSY_POLL_TIME 10
+#define AHT21_MAX_BUSY_POLLS 5
+// wait this long before trying again after the sensor did not answer
+#define AHT21_RETRY_TIME 1000
+// a missing sensor NACKs its address, give up on it right away instead of
+// retrying on the bus, the task tries again after AHT21_RETRY_TIME
+#define AHT21_I2C_TIMEOUT 1
+// how often a queued transfer is checked on
+#define AHT21_TRANSFER_POLL_TIME 1
+
+// time between samples, also the sample age at most. the datasheet advises
+// against more than one conversion every 2 seconds because of self-heating.
+#ifndef AHT21_SAMPLE_INTERVAL
+#    define AHT21_SAMPLE_INTERVAL 10000
+#endif
+
+typedef enum {
+    AHT21_OK,
+    AHT21_BUSY,
+    AHT21_ERROR,
+} aht21_status_t;
+
+typedef enum {
+    AHT21_STATE_TRIGGER,
+    AHT21_STATE_TRIGGERING,
+    AHT21_STATE_CONVERTING,
+    AHT21_STATE_READING,
+} aht21_state_t;
+
+static deferred_token aht21_token = INVALID_DEFERRED_TOKEN;
+static aht21_state_t aht21_state;
+static uint8_t aht21_busy_polls;
+static sensor_data_t aht21_sample;
+static uint8_t aht21_sample_seq;
+
+static const uint8_t aht21_trigger_cmd[] = {0xac, 0x33, 0x00};
+// status byte, 20 bits humidity, 20 bits temperature, crc
+static uint8_t aht21_buf[7];
+
+#ifdef I2C_ASYNC_ENABLE
+// the trigger and the read of the task, queued while the task sleeps
+static i2c_async_transfer_t aht21_transfer;
+#endif
+
 
 bool trig_aht21(void) {
-    const unsigned char trig[] = {0xac, 0x33, 0x00};
-    return (i2c_transmit(AHT21_ADDR << 1, &trig[0], 3, 100) == I2C_STATUS_SUCCESS);
+    return (i2c_transmit(AHT21_ADDR << 1, aht21_trigger_cmd, sizeof(aht21_trigger_cmd), AHT21_I2C_TIMEOUT) == I2C_STATUS_SUCCESS);
 }
 
-bool read_aht21(sensor_data_t *dout) {
-    unsigned char buf[8];
-    if (i2c_receive(AHT21_ADDR << 1, buf, 7, 100) != I2C_STATUS_SUCCESS) {
-        print("eRd\n");
-        return false;
-    }
+static aht21_status_t aht21_parse(const uint8_t *buf, sensor_data_t *dout) {
     if (buf[0] & 0x80) {
-        print("eBusy\n");
-        return false;
+        return AHT21_BUSY;
     }
 
     // the sensor gives 20 bits data for H and T, in pattern as follow,
     // HHHHHHHH, HHHHHHHH, HHHHTTTT, TTTTTTTT, TTTTTTTT
-    // but we only use 16 bit data each. the least 4 bits are ignored.
-
-    uint16_t a = buf[1];
-    a <<= 8;
-    a |= buf[2];
+    // H% = raw / 2^20 * 100, T = raw / 2^20 * 200 - 50, scaled by 10 and rounded
 
-    float f = a;
-    f /= 0x10000;
-    f *= 100;
-    dout->h_int = (int)f;
-    dout->h_dec = (int)((f - (int)f) * 10);
+    uint32_t raw = buf[1];
+    raw = (raw << 8) | buf[2];
+    raw = (raw << 4) | (buf[3] >> 4);
+    dout->h_x10 = (raw * 1000 + (1UL << 19)) >> 20;
 
+    raw = buf[3] & 0x0f;
+    raw = (raw << 8) | buf[4];
+    raw = (raw << 8) | buf[5];
+    dout->t_x10 = (int16_t)((raw * 2000 + (1UL << 19)) >> 20) - 500;
+    return AHT21_OK;
+}
 
+static aht21_status_t aht21_read(sensor_data_t *dout) {
+    uint8_t buf[sizeof(aht21_buf)];
+    if (i2c_receive(AHT21_ADDR << 1, buf, sizeof(buf), AHT21_I2C_TIMEOUT) != I2C_STATUS_SUCCESS) {
+        print("eRd\n");
+        return AHT21_ERROR;
+    }
+    return aht21_parse(buf, dout);
+}
 
-    a = (buf[3] & 0x0f);
-    a <<= 8;
-    a |= buf[4];
-    a <<= 4;
-    a |= (0x0f & (buf[5]>>4));
+bool read_aht21(sensor_data_t *dout) {
+    aht21_status_t status = aht21_read(dout);
+    if (status == AHT21_BUSY) {
+        print("eBusy\n");
+    }
+    return status == AHT21_OK;
+}
 
-    f = a;
-    f /= 0x10000;
-    f = f*200 - 50;
-    dout->t_int = (int)f;
-    dout->t_dec = (int)((f - (int)f) * 10);
+// stores a finished read, false while the sensor is still converting
+static bool aht21_store(aht21_status_t status, const sensor_data_t *sample) {
+    switch (status) {
+        case AHT21_BUSY:
+            if (++aht21_busy_polls < AHT21_MAX_BUSY_POLLS) return false;
+            break;
+        case AHT21_OK:
+            aht21_sample = *sample;
+            // 0 is kept for "no sample yet"
+            if (++aht21_sample_seq == 0) aht21_sample_seq = 1;
+            break;
+        case AHT21_ERROR:
+            break;
+    }
     return true;
 }
+
+// trigger, wait for the conversion, read, sleep until the next sample. never blocks,
+// with I2C_ASYNC_ENABLE the transfers are queued and checked on instead of waited for.
+static uint32_t aht21_task(uint32_t trigger_time, void *cb_arg) {
+    sensor_data_t sample;
+    aht21_status_t status;
+
+    switch (aht21_state) {
+        case AHT21_STATE_TRIGGER:
+#ifdef I2C_ASYNC_ENABLE
+            if (i2c_transmit_async(&aht21_transfer, AHT21_ADDR << 1, aht21_trigger_cmd, sizeof(aht21_trigger_cmd), NULL) != I2C_STATUS_PENDING) return AHT21_RETRY_TIME;
+            aht21_state = AHT21_STATE_TRIGGERING;
+            return AHT21_TRANSFER_POLL_TIME;
+
+        case AHT21_STATE_TRIGGERING:
+            if (i2c_async_status(&aht21_transfer) == I2C_STATUS_PENDING) return AHT21_TRANSFER_POLL_TIME;
+            if (i2c_async_status(&aht21_transfer) != I2C_STATUS_SUCCESS) {
+                aht21_state = AHT21_STATE_TRIGGER;
+                return AHT21_RETRY_TIME;
+            }
+#else
+            if (!trig_aht21()) return AHT21_RETRY_TIME;
+#endif
+            aht21_state = AHT21_STATE_CONVERTING;
+            aht21_busy_polls = 0;
+            return AHT21_MEASURE_TIME;
+
+        case AHT21_STATE_CONVERTING:
+#ifdef I2C_ASYNC_ENABLE
+            if (i2c_receive_async(&aht21_transfer, AHT21_ADDR << 1, aht21_buf, sizeof(aht21_buf), NULL) == I2C_STATUS_PENDING) {
+                aht21_state = AHT21_STATE_READING;
+                return AHT21_TRANSFER_POLL_TIME;
+            }
+            status = AHT21_ERROR;
+#else
+            status = aht21_read(&sample);
+#endif
+            break;
+
+        case AHT21_STATE_READING:
+        default:
+#ifdef I2C_ASYNC_ENABLE
+            if (i2c_async_status(&aht21_transfer) == I2C_STATUS_PENDING) return AHT21_TRANSFER_POLL_TIME;
+            status = i2c_async_status(&aht21_transfer) == I2C_STATUS_SUCCESS ? aht21_parse(aht21_buf, &sample) : AHT21_ERROR;
+#else
+            status = AHT21_ERROR;
+#endif
+            break;
+    }
+
+    if (!aht21_store(status, &sample)) {
+        aht21_state = AHT21_STATE_CONVERTING;
+        return AHT21_BUSY_POLL_TIME;
+    }
+    aht21_state = AHT21_STATE_TRIGGER;
+    return AHT21_SAMPLE_INTERVAL - AHT21_MEASURE_TIME;
+}
+
+void aht21_start(void) {
+    if (aht21_token != INVALID_DEFERRED_TOKEN) return;
+
+    aht21_state = AHT21_STATE_TRIGGER;
+    aht21_token = defer_exec(AHT21_POWER_UP_TIME, aht21_task, NULL);
+}
+
+void aht21_stop(void) {
+    if (aht21_token == INVALID_DEFERRED_TOKEN) return;
+
+    cancel_deferred_exec(aht21_token);
+    aht21_token = INVALID_DEFERRED_TOKEN;
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_abort(&aht21_transfer);
+#endif
+}
+
+// copies the last sample, no bus traffic.
+// returns its sequence number, which changes with each new sample, or 0 if there is none yet.
+uint8_t aht21_get_sample(sensor_data_t *dout) {
+    *dout = aht21_sample;
+    return aht21_sample_seq;
+}
@@ -1,15 +1,15 @@
 #pragma once
 #include "quantum.h"
 
+// one sample, in tenths of a degree celsius and tenths of a percent
 typedef struct {
-    uint8_t h_int;
-    uint8_t h_dec;
-    uint8_t t_int;
-    uint8_t t_dec;
+    int16_t  t_x10;
+    uint16_t h_x10;
 } sensor_data_t;
 
 bool trig_aht21(void);
 bool read_aht21(sensor_data_t* dout);
 
-float get_humidity_float(const sensor_data_t* din);
-float get_temperature_float(const sensor_data_t* din);
+void aht21_start(void);
+void aht21_stop(void);
+uint8_t aht21_get_sample(sensor_data_t* dout);
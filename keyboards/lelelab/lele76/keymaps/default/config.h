@@ -8,9 +8,32 @@
 #define OLED_DISABLE_TIMEOUT 5
 
 #define F_SCL   400000UL
+// interrupt driven TWI, queued transfers shift out while the main loop runs
+#define I2C_ASYNC_ENABLE
+// join queued tiny85 settings into CMD_BATCH frames, needs tiny85 firmware that knows the opcode
+// #define TINYRGB_BATCH_ENABLE
 
 #define TASK_TIME_LIMIT 1
 
+// count main loop passes, holding fn on the dashboard shows scans/s
+// #define DEBUG_MATRIX_SCAN_RATE
+
+// aht21 sampling is the only deferred task
+#define MAX_DEFERRED_EXECUTORS 2
+
 #define ENCODER_MAP_KEY_DELAY  40
 #define TAP_CODE_DELAY  40
+// encoder volume/media taps are paced by the poll interval instead of TAP_CODE_DELAY
+#define EXTRA_TAP_QUEUE_ENABLE
+
+// keep the base layer of the VIA keymap in RAM (160 bytes), lookups on it skip the EEPROM
+#define DYNAMIC_KEYMAP_CACHE_LAYERS 1
+
+// park the matrix and sleep between interrupts after 10s without input
+#define KEYBOARD_IDLE_TIMEOUT 10000
+
 
+// external 24C512 read cache window in bytes, see eeprom_24c512A.c
+#define I2C_ROM_CACHE_SIZE 32
+// prefetch the window following the last image between oled frames
+// #define I2C_ROM_READ_AHEAD
@@ -1,13 +1,9 @@
 #include "cube.h"
-#include "sin.h"
+#include "rot3d.h"
 #include "quantum.h"
 #include "progmem.h"
 
 
-#define XCOORD	0
-#define YCOORD	1
-#define ZCOORD	2
-
 #define CUBE_NODES	8
 #define CUBE_EDGES	12
 
@@ -40,48 +36,22 @@ void DrawCubeRotated(uint16_t l_AngleX, uint16_t l_AngleY, uint16_t l_AngleZ)
     const uint8_t l_Xoffset = 128/4*3;
     const uint8_t l_Yoffset = 64/2;
 	uint8_t l_edge, l_n0, l_n1;
+	uint8_t l_projected[CUBE_NODES][2];
 
 	
 	RotateCube(l_AngleX, l_AngleY, l_AngleZ);
+	Project3D(nodes_rotated, l_projected, CUBE_NODES, l_Xoffset, l_Yoffset);
 	
 	for (l_edge=0; l_edge<CUBE_EDGES; l_edge++) {
 		l_n0 = pgm_read_byte(&edges[l_edge][0]);	// Start node
 		l_n1 = pgm_read_byte(&edges[l_edge][1]);	// end node	
 		
-		oled_draw_line(nodes_rotated[l_n0][XCOORD] + l_Xoffset, nodes_rotated[l_n0][YCOORD]+l_Yoffset, nodes_rotated[l_n1][XCOORD]+l_Xoffset, nodes_rotated[l_n1][YCOORD]+l_Yoffset);
+		oled_draw_line(l_projected[l_n0][0], l_projected[l_n0][1], l_projected[l_n1][0], l_projected[l_n1][1], true);
 	}
 }
 
 
 void RotateCube(uint16_t l_AngleX, uint16_t l_AngleY, uint16_t l_AngleZ)
 {
-	uint8_t l_Node;
-	float rotx, roty, rotz, rotxx, rotyy, rotzz, rotxxx, rotyyy, rotzzz;
-	
-	float AngleSineX = SIN(l_AngleX);
-	float AngleCosineX = COS(l_AngleX);
-	float AngleSineY = SIN(l_AngleY);
-	float AngleCosineY = COS(l_AngleY);
-	float AngleSineZ = SIN(l_AngleZ);
-	float AngleCosineZ = COS(l_AngleZ);	
-	
-		
-	for (l_Node = 0; l_Node<CUBE_NODES; l_Node++) {
-		rotz = (float)nodes[l_Node][ZCOORD] * AngleCosineY - (float)nodes[l_Node][XCOORD] * AngleSineY;
-		rotx = (float)nodes[l_Node][ZCOORD] * AngleSineY + (float)nodes[l_Node][XCOORD] * AngleCosineY;
-		roty = (float)nodes[l_Node][YCOORD];
-		
-		rotyy = roty * AngleCosineX - rotz * AngleSineX;
-		rotzz = roty * AngleSineX + rotz * AngleCosineX;
-		rotxx = rotx;
-		
-		rotxxx = rotxx * AngleCosineZ - rotyy * AngleSineZ;
-		rotyyy = rotxx * AngleSineZ + rotyy * AngleCosineZ;
-		rotzzz = rotzz;
-
-		//store new vertices values for wireframe drawing
-		nodes_rotated[l_Node][XCOORD] = rotxxx;
-		nodes_rotated[l_Node][YCOORD] = rotyyy;
-		nodes_rotated[l_Node][ZCOORD] = rotzzz;
-	}
+	Rotate3D(nodes, nodes_rotated, CUBE_NODES, l_AngleX, l_AngleY, l_AngleZ);
 }
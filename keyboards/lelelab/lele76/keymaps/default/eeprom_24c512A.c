@@ -1,16 +1,52 @@
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
-#include "wait.h"
+#include "timer.h"
 #include "i2c_master.h"
 #include "eeprom_24c512A.h"
+#ifdef OLED_ENABLE
+#    include "oled_driver.h"
+#endif
 
 #define EXTERNAL_EEPROM_ADDRESS_SIZE 2
 #define EXTERNAL_EEPROM_BYTE_COUNT 65536
 #define EXTERNAL_EEPROM_PAGE_SIZE 128
-#define EXTERNAL_EEPROM_WRITE_TIME 3
+#define EXTERNAL_EEPROM_WRITE_TIME 5 // worst case page write cycle in ms
 #define EXTERNAL_EEPROM_I2C_BASE_ADDRESS 0b10101110
 #define EXTERNAL_EEPROM_I2C_ADDRESS(loc) (EXTERNAL_EEPROM_I2C_BASE_ADDRESS)
 
+// bytes fetched per cache window, costs the same amount of sram
+#ifndef I2C_ROM_CACHE_SIZE
+#    define I2C_ROM_CACHE_SIZE 32
+#endif
+#ifndef I2C_ROM_TIMEOUT
+#    define I2C_ROM_TIMEOUT 100
+#endif
+// pending asynchronous writes
+#ifndef I2C_ROM_WRITE_QUEUE_SIZE
+#    define I2C_ROM_WRITE_QUEUE_SIZE 2
+#endif
+_Static_assert(I2C_ROM_CACHE_SIZE > 0 && I2C_ROM_CACHE_SIZE <= 255, "I2C_ROM_CACHE_SIZE must be 1..255");
+
+
+// read cache for streaming assets out of the rom.
+// the first window is fetched by an addressed read, following windows are
+// read from the same open transfer, the rom auto-increments across pages.
+// the bus is held until i2c_eeprom_cache_close().
+static uint8_t i2c_cache_buf[I2C_ROM_CACHE_SIZE];
+static uint8_t i2c_precache_offset;
+static uint8_t i2c_cache_valid;
+static uint16_t i2c_precache_addr;
+static bool i2c_cache_streaming;
+#ifdef I2C_ROM_READ_AHEAD
+static uint16_t i2c_read_ahead_addr;
+static bool i2c_read_ahead_pending;
+#endif
+static i2c_eeprom_cache_stats_t i2c_cache_stats;
+static bool i2c_rom_write_cycle;
+
+static void i2c_eeprom_wait_ready(void);
+
 
 static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     uintptr_t p = (uintptr_t)addr;
@@ -24,53 +60,285 @@ void i2c_eeprom_rd_block(void *buf, const void *addr, size_t len) {
     uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
     fill_target_address(complete_packet, addr);
 
+    i2c_eeprom_cache_close();
+    i2c_eeprom_wait_ready();
     i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
     i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
 }
 
+// write one page (or the part of it from target_addr on), once i2c_eeprom_ready().
+// returns the number of bytes written, 0 on a bus error.
+static uint16_t i2c_eeprom_wr_page(const uint8_t *buf, uint16_t target_addr, uint16_t len) {
+    uint8_t addr_buf[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    uint16_t write_length = EXTERNAL_EEPROM_PAGE_SIZE - (target_addr % EXTERNAL_EEPROM_PAGE_SIZE);
+    if (write_length > len) {
+        write_length = len;
+    }
+
+    i2c_status_t status = i2c_start(EXTERNAL_EEPROM_I2C_ADDRESS(target_addr) | I2C_WRITE, I2C_ROM_TIMEOUT);
+    fill_target_address(addr_buf, (const void *)(uintptr_t)target_addr);
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE && status >= 0; i++) {
+        status = i2c_write(addr_buf[i], I2C_ROM_TIMEOUT);
+    }
+    for (uint16_t i = 0; i < write_length && status >= 0; i++) {
+        status = i2c_write(buf[i], I2C_ROM_TIMEOUT);
+    }
+    i2c_stop();
+
+    i2c_rom_write_cycle = true;
+    return status < 0 ? 0 : write_length;
+}
+
+#ifdef I2C_ASYNC_ENABLE
+// ACK polling: while the rom is busy with its internal write cycle it does not
+// acknowledge its address. the probe is an address-only transfer on the
+// interrupt driven engine, its result is picked up by the next call.
+static i2c_async_transfer_t i2c_rom_probe;
+static bool                 i2c_rom_probing;
+
+bool i2c_eeprom_ready(void) {
+    if (!i2c_rom_write_cycle) return true;
+
+    if (i2c_rom_probing) {
+        i2c_status_t status = i2c_async_status(&i2c_rom_probe);
+        if (status == I2C_STATUS_PENDING) return false;
+        i2c_rom_probing = false;
+        if (status == I2C_STATUS_SUCCESS) {
+            i2c_rom_write_cycle = false;
+            return true;
+        }
+    }
+
+    i2c_rom_probing = i2c_transmit_async(&i2c_rom_probe, EXTERNAL_EEPROM_I2C_ADDRESS(0), NULL, 0, NULL) == I2C_STATUS_PENDING;
+    return false;
+}
+#else
+// without the interrupt driven engine a busy rom costs one timer tick of start retries
+bool i2c_eeprom_ready(void) {
+    if (!i2c_rom_write_cycle) return true;
+
+    i2c_status_t status = i2c_start(EXTERNAL_EEPROM_I2C_ADDRESS(0) | I2C_WRITE, I2C_TIMEOUT_IMMEDIATE);
+    i2c_stop();
+    if (status < 0) return false;
+
+    i2c_rom_write_cycle = false;
+    return true;
+}
+#endif
+
+static void i2c_eeprom_wait_ready(void) {
+    uint16_t timer = timer_read();
+    while (!i2c_eeprom_ready() && timer_elapsed(timer) <= EXTERNAL_EEPROM_WRITE_TIME * 2) {
+    }
+}
+
 void i2c_eeprom_wr_block(const void *buf, void *addr, size_t len) {
-    uint8_t   complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
-    uint8_t * read_buf    = (uint8_t *)buf;
-    uintptr_t target_addr = (uintptr_t)addr;
+    const uint8_t *read_buf    = (const uint8_t *)buf;
+    uint16_t       target_addr = (uintptr_t)addr;
+
+    i2c_eeprom_cache_close();
+    i2c_cache_valid = 0; // cached data may be stale now
 
     while (len > 0) {
-        uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
-        int       write_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
-        if (write_length > len) {
-            write_length = len;
+        i2c_eeprom_wait_ready();
+        uint16_t written = i2c_eeprom_wr_page(read_buf, target_addr, len);
+        if (!written) return; // rom never answered
+
+        read_buf += written;
+        target_addr += written;
+        len -= written;
+    }
+}
+
+// queued writes, advanced one page per i2c_eeprom_write_task() call
+typedef struct {
+    const uint8_t *buf;
+    uint16_t addr;
+    uint16_t len;
+} i2c_rom_write_job_t;
+
+static i2c_rom_write_job_t i2c_rom_write_queue[I2C_ROM_WRITE_QUEUE_SIZE];
+static uint8_t i2c_rom_write_head;
+static uint8_t i2c_rom_write_count;
+
+bool i2c_eeprom_wr_async(const void *buf, uint16_t addr, uint16_t len) {
+    if (i2c_rom_write_count >= I2C_ROM_WRITE_QUEUE_SIZE) return false;
+    if (!len) return true;
+
+    i2c_rom_write_job_t *job = &i2c_rom_write_queue[(i2c_rom_write_head + i2c_rom_write_count) % I2C_ROM_WRITE_QUEUE_SIZE];
+    job->buf = (const uint8_t *)buf;
+    job->addr = addr;
+    job->len = len;
+    i2c_rom_write_count++;
+    return true;
+}
+
+bool i2c_eeprom_wr_busy(void) {
+    return i2c_rom_write_count || i2c_rom_write_cycle;
+}
+
+// returns true if a page was written or the last write cycle finished
+static bool i2c_eeprom_write_step(void) {
+    if (!i2c_rom_write_count) {
+        // settle the write cycle flag of the last page
+        return i2c_rom_write_cycle && i2c_eeprom_ready();
+    }
+
+    if (!i2c_eeprom_ready()) return false; // busy, try again next tick
+
+    i2c_rom_write_job_t *job = &i2c_rom_write_queue[i2c_rom_write_head];
+
+    i2c_eeprom_cache_close();
+    uint16_t written = i2c_eeprom_wr_page(job->buf, job->addr, job->len);
+    if (!written) return false;
+
+    // drop the cached window if it overlaps the written bytes
+    if ((uint16_t)(job->addr - i2c_precache_addr) < i2c_cache_valid || (uint16_t)(i2c_precache_addr - job->addr) < written) {
+        i2c_cache_valid = 0;
+    }
+
+    job->buf += written;
+    job->addr += written;
+    job->len -= written;
+    if (!job->len) {
+        i2c_rom_write_head = (i2c_rom_write_head + 1) % I2C_ROM_WRITE_QUEUE_SIZE;
+        i2c_rom_write_count--;
+    }
+    return true;
+}
+
+void i2c_eeprom_write_task(void) {
+    i2c_eeprom_write_step();
+}
+
+void i2c_eeprom_wr_flush(void) {
+    uint16_t timer = timer_read();
+    while (i2c_eeprom_wr_busy()) {
+        if (i2c_eeprom_write_step()) {
+            timer = timer_read();
+        } else if (timer_elapsed(timer) > EXTERNAL_EEPROM_WRITE_TIME * 2) {
+            return; // rom stopped answering
         }
+    }
+}
+
 
-        fill_target_address(complete_packet, (const void *)target_addr);
-        for (uint8_t i = 0; i < write_length; i++) {
-            complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + i] = read_buf[i];
+// read one window from the open transfer
+static void i2c_eeprom_stream_fill(void) {
+    i2c_precache_offset = 0;
+    for (i2c_cache_valid = 0; i2c_cache_valid < I2C_ROM_CACHE_SIZE; i2c_cache_valid++) {
+        int16_t data = i2c_read_ack(I2C_ROM_TIMEOUT);
+        if (data < 0) {
+            i2c_stop();
+            i2c_cache_streaming = false;
+            return;
         }
+        i2c_cache_buf[i2c_cache_valid] = data;
+    }
+}
 
-        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
-        wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+// addressed read: set the rom address pointer, then turn the bus around for reading
+static void i2c_eeprom_stream_open(uint16_t eeprom_addr) {
+    uint8_t addr_buf[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    fill_target_address(addr_buf, (const void *)(uintptr_t)eeprom_addr);
 
-        read_buf += write_length;
-        target_addr += write_length;
-        len -= write_length;
+    i2c_precache_addr = eeprom_addr;
+    i2c_precache_offset = 0;
+    i2c_cache_valid = 0;
+
+    i2c_eeprom_wait_ready();
+    i2c_status_t status = i2c_start(EXTERNAL_EEPROM_I2C_ADDRESS(eeprom_addr) | I2C_WRITE, I2C_ROM_TIMEOUT);
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE && status >= 0; i++) {
+        status = i2c_write(addr_buf[i], I2C_ROM_TIMEOUT);
+    }
+    if (status >= 0) {
+        status = i2c_start(EXTERNAL_EEPROM_I2C_ADDRESS(eeprom_addr) | I2C_READ, I2C_ROM_TIMEOUT);
     }
+    if (status < 0) {
+        i2c_stop();
+        return;
+    }
+
+    i2c_cache_streaming = true;
+    i2c_eeprom_stream_fill();
 }
 
+static void i2c_eeprom_stream_end(void) {
+    if (!i2c_cache_streaming) return;
 
+    // the master has to NACK the last byte it reads before the stop
+    i2c_read_nack(I2C_ROM_TIMEOUT);
+    i2c_stop();
+    i2c_cache_streaming = false;
+}
+
+void i2c_eeprom_cache_close(void) {
+    if (!i2c_cache_streaming) return;
+
+    i2c_eeprom_stream_end();
+#ifdef I2C_ROM_READ_AHEAD
+    i2c_read_ahead_addr = i2c_precache_addr + i2c_cache_valid;
+    i2c_read_ahead_pending = true;
+#endif
+}
 
-#define I2C_CACHE_SIZE 16
-static uint8_t i2c_cache_buf[I2C_CACHE_SIZE];
-static uint8_t i2c_precache_offset;
-static uint16_t i2c_precache_addr;
 void i2c_eeprom_load_cache(uint16_t eeprom_addr) {
-    i2c_eeprom_rd_block(i2c_cache_buf, (void*)eeprom_addr, I2C_CACHE_SIZE);
-    i2c_precache_offset = 0; 
-    i2c_precache_addr = eeprom_addr;
+    if ((uint16_t)(eeprom_addr - i2c_precache_addr) < i2c_cache_valid) {
+        // an open transfer still continues right after the cached window
+        i2c_cache_stats.hits++;
+        i2c_precache_offset = eeprom_addr - i2c_precache_addr;
+        return;
+    }
+
+    i2c_cache_stats.misses++;
+    i2c_eeprom_cache_close();
+    i2c_eeprom_stream_open(eeprom_addr);
 }
+
 uint8_t i2c_eeprom_cache_rd(void) {
-    if (i2c_precache_offset >= I2C_CACHE_SIZE) {
-        i2c_precache_addr += I2C_CACHE_SIZE;
-        i2c_eeprom_load_cache(i2c_precache_addr);
-    }    
+    if (i2c_precache_offset >= i2c_cache_valid) {
+        uint16_t next_addr = i2c_precache_addr + i2c_cache_valid;
+        if (i2c_cache_streaming) {
+            // continue the open sequential read, no addressing needed
+            i2c_cache_stats.continuations++;
+            i2c_precache_addr = next_addr;
+            i2c_eeprom_stream_fill();
+        } else {
+            i2c_cache_stats.misses++;
+            i2c_eeprom_stream_open(next_addr);
+        }
+        if (!i2c_cache_valid) return 0xff;
+    }
 
     return i2c_cache_buf[i2c_precache_offset++];
 }
 
+// refill the window following the last stream, call between oled frames.
+// a later i2c_eeprom_load_cache() on that address is then served from ram.
+void i2c_eeprom_cache_task(void) {
+#ifdef I2C_ROM_READ_AHEAD
+    if (!i2c_read_ahead_pending) return;
+    i2c_read_ahead_pending = false;
+
+    i2c_cache_stats.read_aheads++;
+    i2c_eeprom_stream_open(i2c_read_ahead_addr);
+    i2c_eeprom_stream_end();
+#endif
+}
+
+void i2c_eeprom_cache_get_stats(i2c_eeprom_cache_stats_t *stats) {
+    *stats = i2c_cache_stats;
+}
+
+void i2c_eeprom_cache_reset_stats(void) {
+    memset(&i2c_cache_stats, 0, sizeof(i2c_cache_stats));
+}
+
+#ifdef OLED_ENABLE
+// draw an image stored by `qmk painter-convert-oled` at the current oled cursor
+void oled_write_compressed_from_I2C_rom(uint16_t eeprom_addr) {
+    i2c_eeprom_load_cache(eeprom_addr);
+    oled_write_compressed(i2c_eeprom_cache_rd);
+    i2c_eeprom_cache_close();
+}
+#endif
@@ -1,7 +1,33 @@
 #pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint16_t hits;          // i2c_eeprom_load_cache() calls served from ram
+    uint16_t misses;        // addressed reads
+    uint16_t continuations; // windows read from an open sequential transfer
+    uint16_t read_aheads;   // windows fetched by i2c_eeprom_cache_task()
+} i2c_eeprom_cache_stats_t;
 
 void i2c_eeprom_rd_block(void *buf, const void *addr, size_t len);
 void i2c_eeprom_wr_block(const void *buf, void *addr, size_t len);
+
+// queue a write and return at once. buf must stay valid until the write is done.
+// returns false if the queue is full.
+bool i2c_eeprom_wr_async(const void *buf, uint16_t addr, uint16_t len);
+// call from housekeeping, writes at most one page per call
+void i2c_eeprom_write_task(void);
+// true while queued data is being written
+bool i2c_eeprom_wr_busy(void);
+// block until every queued write is done
+void i2c_eeprom_wr_flush(void);
+bool i2c_eeprom_ready(void);
+
 void i2c_eeprom_load_cache(uint16_t eeprom_addr);
 uint8_t i2c_eeprom_cache_rd(void);
-
+void i2c_eeprom_cache_close(void);
+void i2c_eeprom_cache_task(void);
+void i2c_eeprom_cache_get_stats(i2c_eeprom_cache_stats_t *stats);
+void i2c_eeprom_cache_reset_stats(void);
+void oled_write_compressed_from_I2C_rom(uint16_t eeprom_addr);
@@ -5,6 +5,8 @@
 #include "apm.h"
 #include "cube.h"
 #include "eeprom_24c512A.h"
+#include "tiny_mcu.h"
+#include "aht_sensor.h"
 
 
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
@@ -46,9 +48,15 @@ void matrix_scan_user(void) {
     decay_apm();
 }
 
+void housekeeping_task_user(void) {
+    tinyrgb_task();
+    i2c_eeprom_write_task();
+}
+
 void keyboard_post_init_user(void) {
     app_init();
     ResizeCube(10);
+    aht21_start();
 }
 
 bool encoder_update_user(uint8_t index, bool clockwise) {
@@ -0,0 +1,51 @@
+#include "rot3d.h"
+#include "sin.h"
+
+// intermediate coordinates carry 6 fraction bits, so every stage of the
+// rotation stays within int16_t and only needs a 16x16->32 bit multiply.
+#define ROT3D_FRAC_BITS 6
+
+static inline int16_t mul_q15(int16_t a, int16_t b) {
+    return (int16_t)(((int32_t)a * b) >> 15);
+}
+
+static inline int8_t round_frac(int16_t a) {
+    return (int8_t)((a + (1 << (ROT3D_FRAC_BITS - 1))) >> ROT3D_FRAC_BITS);
+}
+
+void Rotate3D(const int8_t src[][3], int8_t dst[][3], uint8_t count, uint16_t l_AngleX, uint16_t l_AngleY, uint16_t l_AngleZ)
+{
+	int16_t x, y, z, rotx, roty, rotz, rotyy, rotzz;
+
+	const int16_t AngleSineX = SIN(l_AngleX);
+	const int16_t AngleCosineX = COS(l_AngleX);
+	const int16_t AngleSineY = SIN(l_AngleY);
+	const int16_t AngleCosineY = COS(l_AngleY);
+	const int16_t AngleSineZ = SIN(l_AngleZ);
+	const int16_t AngleCosineZ = COS(l_AngleZ);
+
+	for (uint8_t l_Node = 0; l_Node < count; l_Node++) {
+		x = (int16_t)src[l_Node][XCOORD] << ROT3D_FRAC_BITS;
+		y = (int16_t)src[l_Node][YCOORD] << ROT3D_FRAC_BITS;
+		z = (int16_t)src[l_Node][ZCOORD] << ROT3D_FRAC_BITS;
+
+		rotz = mul_q15(z, AngleCosineY) - mul_q15(x, AngleSineY);
+		rotx = mul_q15(z, AngleSineY) + mul_q15(x, AngleCosineY);
+		roty = y;
+
+		rotyy = mul_q15(roty, AngleCosineX) - mul_q15(rotz, AngleSineX);
+		rotzz = mul_q15(roty, AngleSineX) + mul_q15(rotz, AngleCosineX);
+
+		dst[l_Node][XCOORD] = round_frac(mul_q15(rotx, AngleCosineZ) - mul_q15(rotyy, AngleSineZ));
+		dst[l_Node][YCOORD] = round_frac(mul_q15(rotx, AngleSineZ) + mul_q15(rotyy, AngleCosineZ));
+		dst[l_Node][ZCOORD] = round_frac(rotzz);
+	}
+}
+
+void Project3D(const int8_t src[][3], uint8_t dst[][2], uint8_t count, uint8_t l_Xoffset, uint8_t l_Yoffset)
+{
+	for (uint8_t l_Node = 0; l_Node < count; l_Node++) {
+		dst[l_Node][0] = (uint8_t)(src[l_Node][XCOORD] + l_Xoffset);
+		dst[l_Node][1] = (uint8_t)(src[l_Node][YCOORD] + l_Yoffset);
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <stdint.h>
+
+#define XCOORD	0
+#define YCOORD	1
+#define ZCOORD	2
+
+// rotate `count` nodes around Y, then X, then Z axis. angles are in degree.
+// integer only, no soft-float is pulled in on AVR.
+void Rotate3D(const int8_t src[][3], int8_t dst[][3], uint8_t count, uint16_t l_AngleX, uint16_t l_AngleY, uint16_t l_AngleZ);
+
+// orthographic projection of rotated nodes to screen coordinates
+void Project3D(const int8_t src[][3], uint8_t dst[][2], uint8_t count, uint8_t l_Xoffset, uint8_t l_Yoffset);
@@ -8,8 +8,11 @@ EXTRAKEY_ENABLE = yes
 
 VIA_ENABLE = yes
 ENCODER_MAP_ENABLE = no
+DEFERRED_EXEC_ENABLE = yes
+# time every task of the main loop, with CONSOLE_ENABLE or over VIA
+# TASK_PROFILER_ENABLE = yes
 
 SRC += screen_app.c apm.c aht_sensor.c tiny_mcu.c
 SRC += eeprom_24c512A.c
-SRC += sin.c cube.c
+SRC += sin.c rot3d.c cube.c
 
@@ -7,6 +7,7 @@
 #include "cube.h"
 #include "tiny_mcu.h"
 #include "tiny_mcu_protocol.h"
+#include "eeprom_24c512A.h"
 #include "eeprom.h"
 #include <string.h>
 #include <stdio.h>
@@ -64,7 +65,6 @@ static uint8_t _key_led_i; // for keystroke related led effect
 static char str_buf[23] = {0};
 static uint8_t draw_once_flag = 0;
 static uint8_t _shared_u8;
-static uint16_t _shared_u16;
 static uint8_t init_cnt = 1;
 
 #define MENU_NO_INVERT 0
@@ -112,12 +112,29 @@ const char * const SIDE_LED_EFF_menu_items[] PROGMEM = {
     SIDE_LED_EFF_MENU_4,
 };
 
-static void _side_led_set_eff(void) {
+// mode, brightness and speed go out together, so the side LEDs come back
+// complete after boot or auto-off
+static void _side_led_sync(void) {
     uint8_t eff = eecfg.side.mode;
     if (eff > SideLed_Mode_solid) return;
 
-    const uint8_t data[] = {CMD_SIDE_LED_EFFECT, eff};
-    tiny85_i2c_tx(data, sizeof(data));
+    tiny85_batch_t batch;
+    tiny85_batch_init(&batch);
+    tiny85_batch_add(&batch, CMD_SIDE_LED_EFFECT, eff);
+    tiny85_batch_add(&batch, CMD_SIDE_LED_BRIGHT, eecfg.side.bright);
+    tiny85_batch_add(&batch, CMD_SIDE_LED_SPEED, eecfg.side.speed);
+    tiny85_batch_send(&batch);
+}
+
+// a mode change in the menu. the other settings are already on the tiny85,
+// only a CMD_BATCH frame carries them along for free.
+static void _side_led_set_eff(void) {
+#ifdef TINYRGB_BATCH_ENABLE
+    _side_led_sync();
+#else
+    if (eecfg.side.mode > SideLed_Mode_solid) return;
+    tiny85_i2c_tx_2b(CMD_SIDE_LED_EFFECT, eecfg.side.mode);
+#endif
 }
 
 static bool side_led_effect_rot(bool moveDown) {
@@ -444,8 +461,12 @@ static bool rgb_hue_rot(bool moveDown) {
 }
 
 // SUBAPP: rgb speed
+static uint8_t _rgb_speed_value(void) {
+    return 10+MAX_RGB_SPEED-eecfg.rgb.speed;
+}
+
 static void _rgb_set_speed(void) {
-    tiny85_i2c_tx_2b(CMD_RGB_speed, 10+MAX_RGB_SPEED-eecfg.rgb.speed);
+    tiny85_i2c_tx_2b(CMD_RGB_speed, _rgb_speed_value());
 }
 static void rgb_spd_draw(void) {
     oled_write_P(PSTR("Speed\n\n"), false);
@@ -497,8 +518,27 @@ const char * const RGB_EFFECT_menu_items[] PROGMEM = {
     RGB_EFFECT_MENU_15,
 };
 
+// the effect is sent with all its parameters, the tiny85 is fully in sync
+// after boot or auto-off recovery
+static void _rgb_sync(void) {
+    tiny85_batch_t batch;
+    tiny85_batch_init(&batch);
+    tiny85_batch_add(&batch, CMD_RGB_eff, eecfg.rgb.mode);
+    tiny85_batch_add(&batch, CMD_RGB_satu, eecfg.rgb.satu);
+    tiny85_batch_add(&batch, CMD_RGB_bright, eecfg.rgb.bright);
+    tiny85_batch_add(&batch, CMD_RGB_hue, eecfg.rgb.hue);
+    tiny85_batch_add(&batch, CMD_RGB_hue2, eecfg.rgb.hue2);
+    tiny85_batch_add(&batch, CMD_RGB_speed, _rgb_speed_value());
+    tiny85_batch_send(&batch);
+}
+
+// a mode change in the menu, see _side_led_set_eff()
 static void _rgb_set_eff(void) {
+#ifdef TINYRGB_BATCH_ENABLE
+    _rgb_sync();
+#else
     tiny85_i2c_tx_2b(CMD_RGB_eff, eecfg.rgb.mode);
+#endif
 }
 
 static bool rgb_effect_rot(bool moveDown) {
@@ -1067,11 +1107,81 @@ static void menu_draw_v_scroll(void) {
 static led_t last_led_state;
 
 
+// dashboard text fields. each keeps the text on screen, only glyphs that
+// differ from it are written again. a field is as long as its text, up to
+// the screen edge, and a shorter text blanks what is left of the longer one.
+#define DASH_FIELD_MAX_LEN (OLED_DISPLAY_WIDTH / OLED_FONT_WIDTH)
+#define DASH_GLYPH_UNKNOWN 0xff
+#define DASH_GLYPH_DEGREE 0
+
+enum {
+    DASH_FIELD_APM = 0,
+    DASH_FIELD_KEYS,
+    DASH_FIELD_SENSOR,
+    DASH_FIELD_COUNT,
+};
+
+static const uint8_t dash_field_row[DASH_FIELD_COUNT] = {3, 4, 6};
+static char dash_field_text[DASH_FIELD_COUNT][DASH_FIELD_MAX_LEN];
+static uint8_t dash_field_len[DASH_FIELD_COUNT];
+
+static uint8_t sensor_seq; // sample on screen
+static uint8_t dashboard_fn_flag = 0;
+static uint16_t oled_blocks_per_sec;
+
+static uint8_t dash_fmt_uint(char *dst, uint32_t value) {
+    char digits[10];
+    uint8_t n = 0;
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+
+    for (uint8_t i = 0; i < n; i++) {
+        dst[i] = digits[n - 1 - i];
+    }
+    return n;
+}
+
+static uint8_t dash_fmt_P(char *dst, const char *str) {
+    uint8_t n = 0;
+    char c;
+    while ((c = pgm_read_byte(str++))) {
+        dst[n++] = c;
+    }
+    return n;
+}
+
+static void dash_field_update(uint8_t field, const char *text, uint8_t len) {
+    char *shown = dash_field_text[field];
+    if (len > DASH_FIELD_MAX_LEN) len = DASH_FIELD_MAX_LEN;
+    uint8_t end = len > dash_field_len[field] ? len : dash_field_len[field];
+
+    for (uint8_t i = 0; i < end; i++) {
+        char c = i < len ? text[i] : ' ';
+        if (c == shown[i]) continue;
+        oled_set_cursor(i, dash_field_row[field]);
+        oled_write_char(c, false);
+        shown[i] = c;
+    }
+    dash_field_len[field] = len;
+}
+
+uint16_t get_oled_blocks_per_sec(void) {
+    return oled_blocks_per_sec;
+}
+
 static void dashboard_draw(void) {
+    // long enough for the longest field, "4294967295 scan/s"
+    char text[24];
+    uint8_t len;
+
     if (draw_once_flag) {
         oled_clear();
-        _shared_u16 = 0;
+        sensor_seq = 0;
         last_led_state.raw = 0;
+        memset(dash_field_text, DASH_GLYPH_UNKNOWN, sizeof(dash_field_text));
+        memset(dash_field_len, 0, sizeof(dash_field_len));
     }
     else {
         // led status
@@ -1092,39 +1202,45 @@ static void dashboard_draw(void) {
             }
         }
 
-        // APM part & key cnt part
-        sprintf(str_buf, "%u KPM   ",get_current_apm());
-        oled_set_cursor(0,3);
-        oled_write(str_buf,0);
-
-        sprintf(str_buf, "%lu keys   ",get_key_cnt());
-        oled_set_cursor(0,4);
-        oled_write(str_buf,0);
-
-        // sensor part
-        if (_shared_u16 == 0) {
-            trig_aht21();
+        // APM part & key cnt part, holding fn shows the display traffic instead
+        if (dashboard_fn_flag) {
+            len = dash_fmt_uint(text, oled_blocks_per_sec);
+            len += dash_fmt_P(text + len, PSTR(" blk/s"));
+        } else {
+            len = dash_fmt_uint(text, get_current_apm());
+            len += dash_fmt_P(text + len, PSTR(" KPM"));
         }
-        _shared_u16++;
-    }
-
-    static sensor_data_t sensor_data;
-    if (_shared_u16 == 50) {
-        read_aht21(&sensor_data);
-    }
-    else if (_shared_u16 == 100) {
-        if (is_oled_on()) { // not wake up oled if already off.
-        oled_set_cursor(0,6); 
-        sprintf(str_buf, "%d.%d",sensor_data.t_int, sensor_data.t_dec);
-        oled_write(str_buf,0);
-        oled_write_char(0,0); // degree symbol
-
-        sprintf(str_buf, "C %d%% ",sensor_data.h_int);
-        oled_write(str_buf,0);
+        dash_field_update(DASH_FIELD_APM, text, len);
+
+#ifdef DEBUG_MATRIX_SCAN_RATE
+        if (dashboard_fn_flag) {
+            len = dash_fmt_uint(text, get_matrix_scan_rate());
+            len += dash_fmt_P(text + len, PSTR(" scan/s"));
+        } else
+#endif
+        {
+            len = dash_fmt_uint(text, get_key_cnt());
+            len += dash_fmt_P(text + len, PSTR(" keys"));
+        }
+        dash_field_update(DASH_FIELD_KEYS, text, len);
+
+        // sensor part, sampled in the background, redrawn only when a new sample is in
+        sensor_data_t sensor_data;
+        uint8_t seq = aht21_get_sample(&sensor_data);
+        if (seq && seq != sensor_seq && is_oled_on()) { // not wake up oled if already off.
+            sensor_seq = seq;
+            uint16_t t = sensor_data.t_x10 < 0 ? -sensor_data.t_x10 : sensor_data.t_x10;
+            len = 0;
+            if (sensor_data.t_x10 < 0) text[len++] = '-';
+            len += dash_fmt_uint(text + len, t / 10);
+            text[len++] = '.';
+            text[len++] = '0' + t % 10;
+            text[len++] = DASH_GLYPH_DEGREE;
+            len += dash_fmt_P(text + len, PSTR("C "));
+            len += dash_fmt_uint(text + len, sensor_data.h_x10 / 10);
+            text[len++] = '%';
+            dash_field_update(DASH_FIELD_SENSOR, text, len);
         }
-    }
-    else if (_shared_u16 >= 1100) {
-        _shared_u16 = 0;
     }
 
     if (draw_once_flag) {
@@ -1138,9 +1254,6 @@ static void dashboard_draw(void) {
     if (init_cnt) {
         app_cfg_init();
     }
-    else {
-        tinyrgb_task();
-    }
     
 
     // homeart part
@@ -1160,8 +1273,6 @@ static void dashboard_draw(void) {
 }
 
 
-static uint8_t dashboard_fn_flag = 0;
-
 static bool dashboard_on_rot(bool moveDown) {
     if (dashboard_fn_flag) {
         if (moveDown) eecfg.homeart_id ++;
@@ -1323,11 +1434,11 @@ void app_draw(void) {
 
         if (is_rgb_idle_off) { // RGB recover from auto-off
             is_rgb_idle_off = 0;
-            _rgb_set_eff();
+            _rgb_sync();
         }
         else if (is_side_idle_off) { // side recover from auto-off
             is_side_idle_off = 0;
-            _side_led_set_eff();
+            _side_led_sync();
         }
         else if (tiny85_i2c_tx_2b(CMD_RGB_keypress, _key_led_i) == I2C_STATUS_SUCCESS) {
             _key_led_i = 0xff;
@@ -1336,6 +1447,17 @@ void app_draw(void) {
 
     f_draw();
     draw_once_flag = 0;
+
+    // blocks sent to the oled in the last second
+    static uint16_t blocks_timer, blocks_last;
+    if (timer_elapsed(blocks_timer) >= 1000) {
+        uint16_t blocks = oled_get_blocks_sent();
+        blocks_timer = timer_read();
+        oled_blocks_per_sec = blocks - blocks_last;
+        blocks_last = blocks;
+    }
+
+    i2c_eeprom_cache_task();
 }
 
 
@@ -1485,32 +1607,11 @@ static void app_cfg_init(void) {
             is_side_idle_off = 0;
             break;
         case 2:
-            _rgb_set_eff();
+            _rgb_sync();
             break;
         case 3:
-            tiny85_i2c_tx_2b(CMD_RGB_satu, eecfg.rgb.satu);
-            break;
-        case 4:
-            tiny85_i2c_tx_2b(CMD_RGB_bright, eecfg.rgb.bright);
-            break;
-        case 5:
-            tiny85_i2c_tx_2b(CMD_RGB_hue, eecfg.rgb.hue);
-            break;
-        case 6:
-            tiny85_i2c_tx_2b(CMD_RGB_hue2, eecfg.rgb.hue2);
-            break;
-        case 7:
-            _rgb_set_speed();
-            break;
-        case 8:
-            _side_led_set_eff();
-            break;
-        case 9:
-            _side_led_set_bright(eecfg.side.bright);
-            break;
-        case 10:
         default:
-            _side_led_set_speed(eecfg.side.speed);
+            _side_led_sync();
             init_cnt = 0;
             return;
     }
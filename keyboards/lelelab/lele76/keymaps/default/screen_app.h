@@ -5,3 +5,5 @@ void app_draw(void);
 bool app_on_key(uint16_t keycode, keyrecord_t *record);
 bool app_on_rotate(bool clockwise);
 void tiny_cfg_init(void);
+// blocks sent to the oled in the last second, also shown on the dashboard while fn is held
+uint16_t get_oled_blocks_per_sec(void);
@@ -1,4 +1,8 @@
 #pragma once
+#include <stdint.h>
 
-float SIN(uint16_t angle);
-float COS(uint16_t angle);
+// fixed-point trigonometry, angle in degree, result in Q1.15
+#define TRIG_Q15_ONE 32767
+
+int16_t SIN(uint16_t angle);
+int16_t COS(uint16_t angle);
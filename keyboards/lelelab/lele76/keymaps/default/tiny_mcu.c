@@ -14,9 +14,31 @@
 #define TINYRGB_ERROR_LENGTH    2
 
 
-static uint8_t tinyrgb_cmd_buf[5];
-static uint8_t tinyrgb_cmd_len;
-
+#ifndef TINYRGB_QUEUE_SIZE
+#    define TINYRGB_QUEUE_SIZE 8
+#endif
+#define TINYRGB_CMD_MAX_LEN 5
+
+// commands waiting for the tiny85 to drop its busy pin. a queued setting is
+// replaced by a later one with the same opcode, only the latest value matters.
+typedef struct {
+    uint8_t len;
+    uint8_t data[TINYRGB_CMD_MAX_LEN];
+} tinyrgb_cmd_t;
+
+static tinyrgb_cmd_t tinyrgb_queue[TINYRGB_QUEUE_SIZE];
+static uint8_t tinyrgb_queue_head;
+static uint8_t tinyrgb_queue_count;
+static tinyrgb_stats_t tinyrgb_stats;
+#ifdef TINYRGB_BATCH_ENABLE
+// queued 2-byte commands at the head are joined into one CMD_BATCH frame when sent
+static uint8_t tinyrgb_frame[TINY_BATCH_FRAME_LEN(TINY_BATCH_MAX_PAIRS)];
+#endif
+#ifdef I2C_ASYNC_ENABLE
+// the head commands while the interrupt driven TWI shifts them out
+static i2c_async_transfer_t tinyrgb_transfer;
+static uint8_t tinyrgb_in_flight;
+#endif
 
 void tiny_busy_port_init(void) {
     DDRD &= ~(1<<TINY_BUSY_PIN); // INPUT
@@ -40,13 +62,48 @@ static i2c_status_t i2c_transmit_buf(uint8_t address, const uint8_t *data, uint1
     return status;
 }
 
+static bool tinyrgb_enqueue(const uint8_t * data, uint8_t length) {
+    uint8_t i = 0;
+#ifdef I2C_ASYNC_ENABLE
+    i = tinyrgb_in_flight; // the head is on the bus, leave its buffers alone
+#endif
+    for (; i < tinyrgb_queue_count; i++) {
+        tinyrgb_cmd_t *cmd = &tinyrgb_queue[(tinyrgb_queue_head + i) % TINYRGB_QUEUE_SIZE];
+        // keystroke events are not settings, each of them is kept
+        if (cmd->len == length && cmd->data[0] == data[0] && data[0] != CMD_RGB_keypress) {
+            memcpy(cmd->data, data, length);
+            tinyrgb_stats.coalesced++;
+            return true;
+        }
+    }
+
+    if (tinyrgb_queue_count >= TINYRGB_QUEUE_SIZE) {
+        tinyrgb_stats.dropped++;
+        return false;
+    }
+
+    tinyrgb_cmd_t *cmd = &tinyrgb_queue[(tinyrgb_queue_head + tinyrgb_queue_count) % TINYRGB_QUEUE_SIZE];
+    cmd->len = length;
+    memcpy(cmd->data, data, length);
+    tinyrgb_queue_count++;
+    if (tinyrgb_queue_count > tinyrgb_stats.max_depth) {
+        tinyrgb_stats.max_depth = tinyrgb_queue_count;
+    }
+    return true;
+}
+
+// sends right away when the tiny85 is idle and nothing is queued before it,
+// otherwise the command is queued for tinyrgb_task().
+// returns I2C_ERROR_TINY_BUSY only if the command had to be dropped.
 i2c_status_t tiny85_i2c_tx(const uint8_t * data, uint8_t length) {
-    if (is_tiny_busy()) {
-        tinyrgb_cmd_len = length;
-        memcpy(tinyrgb_cmd_buf, data, length);
-        return I2C_ERROR_TINY_BUSY;
+    if (!length || length > TINYRGB_CMD_MAX_LEN) return I2C_STATUS_ERROR;
+
+    if (!tinyrgb_queue_count && !is_tiny_busy()) {
+        i2c_status_t status = i2c_transmit_buf(TINY_ADDR_WR, data, length, I2C_DEF_TIMEOUT);
+        if (status == I2C_STATUS_SUCCESS) return status;
     }
-    return i2c_transmit_buf(TINY_ADDR_WR, data, length, I2C_DEF_TIMEOUT);
+
+    return tinyrgb_enqueue(data, length) ? I2C_STATUS_SUCCESS : I2C_ERROR_TINY_BUSY;
 }
 
 i2c_status_t tiny85_i2c_tx_2b(uint8_t cmd, uint8_t byte) {
@@ -56,14 +113,127 @@ i2c_status_t tiny85_i2c_tx_2b(uint8_t cmd, uint8_t byte) {
     return tiny85_i2c_tx(buf,2);
 }
 
-bool tinyrgb_task(void) {
-    if (!tinyrgb_cmd_len) return false;
-    if (is_tiny_busy()) return false;
+void tiny85_batch_init(tiny85_batch_t *batch) {
+    batch->count = 0;
+}
 
-    uint8_t ans = i2c_transmit_buf(TINY_ADDR_WR, tinyrgb_cmd_buf, tinyrgb_cmd_len, I2C_DEF_TIMEOUT);
-    if (ans == I2C_STATUS_SUCCESS) {
-        tinyrgb_cmd_len = 0;
-    }
+// returns false if the batch is full, the command is not added then
+bool tiny85_batch_add(tiny85_batch_t *batch, uint8_t cmd, uint8_t value) {
+    if (batch->count >= TINY_BATCH_MAX_PAIRS) return false;
+
+    batch->data[2*batch->count] = cmd;
+    batch->data[2*batch->count + 1] = value;
+    batch->count++;
     return true;
 }
 
+#ifdef TINYRGB_BATCH_ENABLE
+// builds a CMD_BATCH frame around the pairs already in frame[2..], returns its length
+static uint8_t tinyrgb_frame_close(uint8_t *frame, uint8_t count) {
+    uint8_t length = TINY_BATCH_FRAME_LEN(count);
+    uint8_t sum = 0;
+
+    frame[0] = CMD_BATCH;
+    frame[1] = count;
+    for (uint8_t i = 0; i < length - 1; i++) {
+        sum += frame[i];
+    }
+    frame[length - 1] = -sum;
+    return length;
+}
+#endif
+
+// the commands go out as separate 2-byte commands, in order. with
+// TINYRGB_BATCH_ENABLE an idle tiny85 gets them in one CMD_BATCH frame, queued
+// ones are joined again by tinyrgb_task().
+i2c_status_t tiny85_batch_send(tiny85_batch_t *batch) {
+    if (batch->count == 0) return I2C_STATUS_SUCCESS;
+
+#ifdef TINYRGB_BATCH_ENABLE
+    if (batch->count > 1 && !tinyrgb_queue_count && !is_tiny_busy()) {
+        uint8_t frame[TINY_BATCH_FRAME_LEN(TINY_BATCH_MAX_PAIRS)];
+        memcpy(&frame[2], batch->data, 2*batch->count);
+        uint8_t length = tinyrgb_frame_close(frame, batch->count);
+        if (i2c_transmit_buf(TINY_ADDR_WR, frame, length, I2C_DEF_TIMEOUT) == I2C_STATUS_SUCCESS) return I2C_STATUS_SUCCESS;
+    }
+#endif
+
+    i2c_status_t status = I2C_STATUS_SUCCESS;
+    for (uint8_t i = 0; i < batch->count; i++) {
+        if (tiny85_i2c_tx(&batch->data[2*i], 2) != I2C_STATUS_SUCCESS) status = I2C_ERROR_TINY_BUSY;
+    }
+    return status;
+}
+
+// next transaction from the head of the queue: the head command, or with
+// TINYRGB_BATCH_ENABLE the 2-byte commands at the head joined into one frame.
+// returns how many queued commands it carries.
+static uint8_t tinyrgb_next(const uint8_t **data, uint8_t *length) {
+    tinyrgb_cmd_t *cmd = &tinyrgb_queue[tinyrgb_queue_head];
+    *data = cmd->data;
+    *length = cmd->len;
+
+#ifdef TINYRGB_BATCH_ENABLE
+    uint8_t count = 0;
+    while (count < tinyrgb_queue_count && count < TINY_BATCH_MAX_PAIRS) {
+        cmd = &tinyrgb_queue[(tinyrgb_queue_head + count) % TINYRGB_QUEUE_SIZE];
+        if (cmd->len != 2) break;
+        tinyrgb_frame[2 + 2*count] = cmd->data[0];
+        tinyrgb_frame[3 + 2*count] = cmd->data[1];
+        count++;
+    }
+    if (count > 1) {
+        *data = tinyrgb_frame;
+        *length = tinyrgb_frame_close(tinyrgb_frame, count);
+        return count;
+    }
+#endif
+    return 1;
+}
+
+static void tinyrgb_pop(uint8_t count) {
+    tinyrgb_queue_head = (tinyrgb_queue_head + count) % TINYRGB_QUEUE_SIZE;
+    tinyrgb_queue_count -= count;
+}
+
+// send the oldest queued command if the tiny85 is idle. one transaction per
+// call, the tiny85 needs a moment to raise its busy pin after each of them.
+// returns true if anything is still queued.
+bool tinyrgb_task(void) {
+#ifdef I2C_ASYNC_ENABLE
+    // the commands stay queued until the bus is done with them, failed ones are sent again
+    if (tinyrgb_in_flight) {
+        i2c_status_t status = i2c_async_status(&tinyrgb_transfer);
+        if (status == I2C_STATUS_PENDING) return true;
+
+        if (status == I2C_STATUS_SUCCESS) {
+            tinyrgb_pop(tinyrgb_in_flight);
+        }
+        tinyrgb_in_flight = 0;
+        return tinyrgb_queue_count > 0;
+    }
+#endif
+    if (!tinyrgb_queue_count || is_tiny_busy()) return tinyrgb_queue_count > 0;
+
+    const uint8_t *data;
+    uint8_t length;
+    uint8_t count = tinyrgb_next(&data, &length);
+#ifdef I2C_ASYNC_ENABLE
+    if (i2c_transmit_async(&tinyrgb_transfer, TINY_ADDR_WR, data, length, NULL) == I2C_STATUS_PENDING) {
+        tinyrgb_in_flight = count;
+    }
+#else
+    if (i2c_transmit_buf(TINY_ADDR_WR, data, length, I2C_DEF_TIMEOUT) == I2C_STATUS_SUCCESS) {
+        tinyrgb_pop(count);
+    }
+#endif
+    return tinyrgb_queue_count > 0;
+}
+
+uint8_t tinyrgb_queue_depth(void) {
+    return tinyrgb_queue_count;
+}
+
+void tinyrgb_get_stats(tinyrgb_stats_t *stats) {
+    *stats = tinyrgb_stats;
+}
@@ -1,10 +1,29 @@
 #pragma once
 #include "quantum.h"
 #include "i2c_master.h"
+#include "tiny_mcu_protocol.h"
+
+typedef struct {
+    uint8_t  max_depth;  // deepest the queue has been
+    uint16_t coalesced;  // commands that replaced a queued one with the same opcode
+    uint16_t dropped;    // commands lost because the queue was full
+} tinyrgb_stats_t;
+
+// several (cmd, value) settings sent to the tiny85 together, as one CMD_BATCH
+// frame with TINYRGB_BATCH_ENABLE
+typedef struct {
+    uint8_t count;
+    uint8_t data[2*TINY_BATCH_MAX_PAIRS];
+} tiny85_batch_t;
 
 void tiny_busy_port_init(void);
 uint8_t is_tiny_busy(void);
 i2c_status_t tiny85_i2c_tx(const uint8_t * data, uint8_t length);
 i2c_status_t tiny85_i2c_tx_2b(uint8_t cmd, uint8_t byte);
 bool tinyrgb_task(void);
+uint8_t tinyrgb_queue_depth(void);
+void tinyrgb_get_stats(tinyrgb_stats_t *stats);
 
+void tiny85_batch_init(tiny85_batch_t *batch);
+bool tiny85_batch_add(tiny85_batch_t *batch, uint8_t cmd, uint8_t value);
+i2c_status_t tiny85_batch_send(tiny85_batch_t *batch);
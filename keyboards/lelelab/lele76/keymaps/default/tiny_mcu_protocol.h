@@ -23,9 +23,19 @@ typedef enum {
     CMD_SIDE_LED_BRIGHT, // bright
     CMD_SIDE_LED_SPEED, // speed
 
+    CMD_BATCH = 40, // count, count x (cmd, value), checksum
+
     CMD0_Diag_ping = 50, // length 0, always ack
 } payload_type_enum;
 
+// CMD_BATCH frame: several 2-byte commands in one transaction. only sent with
+// TINYRGB_BATCH_ENABLE, for tiny85 firmware that understands it.
+// checksum is the two's complement of the 8-bit sum of all bytes before it,
+// so all bytes of a valid frame add up to zero. a frame with a bad checksum
+// or count is dropped as a whole.
+#define TINY_BATCH_MAX_PAIRS    6
+#define TINY_BATCH_FRAME_LEN(n) (3 + 2*(n))
+
 
 // RGB modes
 typedef enum
@@ -0,0 +1,36 @@
+"""Converts images to the OLED driver's compressed image format.
+"""
+from qmk.path import normpath
+from qmk.painter_oled import load_frames, encode_oled_image, oled_image_stats
+from milc import cli
+
+
+@cli.argument('-i', '--input', required=True, help='Specify input graphic file. Every frame of an animation is converted.')
+@cli.argument('-o', '--output', default='', help='Specify output directory. Defaults to same directory as input.')
+@cli.argument('--f-scl', default=400000, type=int, help='I2C clock used to estimate the per-frame transfer time. Default: 400000')
+@cli.argument('--read-window', default=16, type=int, help='Bytes fetched per addressed EEPROM read, used to estimate the per-frame transfer time. Default: 16')
+@cli.subcommand('Converts an input image to the compressed format of oled_write_compressed()')
+def painter_convert_oled(cli):
+    """Converts an image file to RLE compressed OLED framebuffer data.
+
+    One `INPUT.bin` (or `INPUT_N.bin` for animations) is written per frame, ready to be stored in external memory and drawn with `oled_write_compressed()`. The compression ratio and estimated decode time of each frame are reported.
+    """
+    cli.args.input = normpath(cli.args.input)
+    if not cli.args.input.exists():
+        cli.log.error('Input image file does not exist!')
+        cli.print_usage()
+        return False
+
+    if len(cli.args.output) == 0:
+        cli.args.output = cli.args.input.parent
+    cli.args.output = normpath(cli.args.output)
+
+    frames = load_frames(cli.args.input)
+    for n, frame in enumerate(frames):
+        stats = oled_image_stats(frame, f_scl=cli.args.f_scl, read_window=cli.args.read_window)
+        name = cli.args.input.stem if len(frames) == 1 else f'{cli.args.input.stem}_{n}'
+        out_file = cli.args.output / (name + '.bin')
+        with open(out_file, 'wb') as out:
+            out.write(encode_oled_image(frame))
+
+        cli.log.info(f"{out_file}: {stats['width']}x{stats['height']}, {stats['raw_size']} -> {stats['encoded_size']} bytes (ratio {stats['ratio']:.2f}), {stats['i2c_reads']} I2C reads, ~{stats['i2c_frame_us']:.0f}us per frame at {cli.args.f_scl // 1000}kHz")
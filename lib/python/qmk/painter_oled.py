@@ -0,0 +1,110 @@
+"""Functions that help us work with the OLED driver's compressed image format.
+
+An image is stored as a two byte header (width in columns, height in 8 pixel
+pages) followed by the page-ordered framebuffer bytes, compressed with the same
+RLE scheme Quantum Painter uses. `oled_write_compressed()` decodes it straight
+into the OLED buffer.
+"""
+from PIL import Image
+
+from qmk.painter import compress_bytes_qmk_rle
+
+# I2C clock cycles per transferred byte, including the ACK bit
+I2C_CLOCKS_PER_BYTE = 9
+
+# I2C clock cycles spent addressing a random read from a 16-bit addressed EEPROM:
+# start + write address + 2 address bytes + repeated start + read address + stop
+I2C_CLOCKS_PER_RANDOM_READ = 2 + 9 + 18 + 2 + 9 + 2
+
+
+def convert_image_to_pages(im):
+    """Converts a PIL image to 1bpp OLED framebuffer bytes.
+
+    Each byte holds 8 vertically stacked pixels, least significant bit at the top, exactly as the OLED driver lays out `oled_buffer`.
+    """
+    im = im.convert('1')
+    width, height = im.size
+    pages = (height + 7) // 8
+    pixels = im.load()
+
+    data = []
+    for page in range(pages):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and pixels[x, y]:
+                    byte |= 1 << bit
+            data.append(byte)
+
+    return (width, pages, data)
+
+
+def encode_oled_image(im):
+    """Encodes a PIL image to the OLED driver's compressed image format.
+    """
+    width, pages, data = convert_image_to_pages(im)
+    if width > 255 or pages > 255:
+        raise ValueError(f"Image too large: {width}x{pages * 8}, must fit in 255 columns by 255 pages")
+
+    return bytes([width, pages] + compress_bytes_qmk_rle(data))
+
+
+def decode_oled_image(encoded):
+    """Decodes the OLED driver's compressed image format, mirroring `oled_write_compressed()`.
+
+    Returns a tuple of (width, pages, framebuffer bytes).
+    """
+    width, pages = encoded[0], encoded[1]
+    total = width * pages
+    data = []
+    pos = 2
+    while len(data) < total:
+        marker = encoded[pos]
+        pos += 1
+        if marker >= 128:
+            count = marker - 127
+            data.extend(encoded[pos:pos + count])
+            pos += count
+        else:
+            data.extend([encoded[pos]] * marker)
+            pos += 1
+
+    return (width, pages, data[:total])
+
+
+def oled_image_stats(im, f_scl=400000, read_window=16):
+    """Measures compression ratio and estimated per-frame decode cost of an image.
+
+    The on-device decode is bound by the I2C transfer of the compressed stream, so the frame time is estimated from the encoded size, the bus clock and the EEPROM read window (bytes fetched per addressed read).
+    """
+    width, pages, raw = convert_image_to_pages(im)
+    encoded = encode_oled_image(im)
+
+    decoded = decode_oled_image(encoded)
+    if decoded[2] != raw:
+        raise ValueError('Round trip mismatch, encoder and decoder disagree')
+
+    reads = -(-len(encoded) // read_window)
+    i2c_clocks = len(encoded) * I2C_CLOCKS_PER_BYTE + reads * I2C_CLOCKS_PER_RANDOM_READ
+
+    return {
+        'width': width,
+        'height': pages * 8,
+        'raw_size': len(raw),
+        'encoded_size': len(encoded),
+        'ratio': len(raw) / len(encoded),
+        'i2c_reads': reads,
+        'i2c_frame_us': i2c_clocks * 1e6 / f_scl,
+    }
+
+
+def load_frames(filename):
+    """Returns every frame of a (possibly animated) image file as a list of PIL images.
+    """
+    im = Image.open(filename)
+    frames = []
+    for n in range(getattr(im, 'n_frames', 1)):
+        im.seek(n)
+        frames.append(im.copy())
+    return frames
@@ -0,0 +1,90 @@
+from PIL import Image, ImageDraw
+
+from qmk.constants import QMK_FIRMWARE
+from qmk.painter_oled import convert_image_to_pages, encode_oled_image, decode_oled_image, oled_image_stats
+
+# Decoded by the real oled_write_compressed() in drivers/oled/tests
+C_FIXTURE = QMK_FIRMWARE / 'drivers/oled/tests/oled_test_images.h'
+
+
+def sample_image(width, height):
+    """An image with long runs (background, filled box) and short ones (diagonal), so both RLE block types show up.
+    """
+    im = Image.new('1', (width, height))
+    draw = ImageDraw.Draw(im)
+    draw.rectangle((2, 2, width // 2, height // 2), fill=1)
+    draw.line((0, height - 1, width - 1, 0), fill=1)
+    for x in range(0, width, 3):
+        im.putpixel((x, height - 1), 1)
+    return im
+
+
+def test_pages_layout():
+    im = Image.new('1', (2, 10))
+    im.putpixel((0, 0), 1)
+    im.putpixel((1, 7), 1)
+    im.putpixel((0, 8), 1)
+    assert convert_image_to_pages(im) == (2, 2, [0x01, 0x80, 0x01, 0x00])
+
+
+def c_array(name, data):
+    lines = [f'static const uint8_t {name}[] = {{']
+    for i in range(0, len(data), 16):
+        lines.append('    ' + ', '.join(f'0x{byte:02X}' for byte in data[i:i + 16]) + ',')
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def c_fixture():
+    """The encoded sample images and their framebuffer bytes, as drivers/oled/tests/oled_test_images.h.
+    """
+    arrays = []
+    for name, (width, height) in (('full', (128, 32)), ('partial', (40, 13))):
+        im = sample_image(width, height)
+        _, _, raw = convert_image_to_pages(im)
+        arrays.append(c_array(f'{name}_encoded', encode_oled_image(im)))
+        arrays.append(c_array(f'{name}_raw', raw))
+
+    header = [
+        '// Copyright 2023 QMK',
+        '// SPDX-License-Identifier: GPL-2.0-or-later',
+        '',
+        '// Generated from sample_image() in lib/python/qmk/tests/test_painter_oled.py, do not edit',
+        '',
+        '#pragma once',
+        '',
+        '#include <stdint.h>',
+    ]
+    return '\n'.join(header) + '\n\n' + '\n\n'.join(arrays) + '\n'
+
+
+def test_round_trip():
+    im = sample_image(128, 32)
+    width, pages, raw = convert_image_to_pages(im)
+    encoded = encode_oled_image(im)
+
+    assert encoded[0] == 128 and encoded[1] == 4
+    assert decode_oled_image(encoded) == (width, pages, raw)
+
+
+def test_round_trip_partial_page():
+    # 13 rows round up to two pages, the rows below the image are blank
+    im = sample_image(40, 13)
+    width, pages, raw = convert_image_to_pages(im)
+
+    assert pages == 2
+    assert decode_oled_image(encode_oled_image(im)) == (width, pages, raw)
+    assert all(byte & 0xE0 == 0 for byte in raw[40:])
+
+
+def test_c_fixture():
+    # The C decoder is tested against this output, regenerate the file if the encoder changes
+    assert C_FIXTURE.read_text() == c_fixture()
+
+
+def test_stats():
+    im = Image.new('1', (128, 32))
+    stats = oled_image_stats(im, read_window=16)
+    assert stats['raw_size'] == 512
+    assert stats['encoded_size'] < stats['raw_size']
+    assert stats['i2c_reads'] == -(-stats['encoded_size'] // 16)
@@ -19,6 +19,11 @@
 
 #include <avr/io.h>
 #include <util/twi.h>
+#ifdef I2C_ASYNC_ENABLE
+#    include <avr/interrupt.h>
+#    include <util/atomic.h>
+#    include <stddef.h>
+#endif
 
 #include "i2c_master.h"
 #include "timer.h"
@@ -38,6 +43,320 @@
 
 #define TWBR_val (((F_CPU / F_SCL) - 16) / 2)
 
+#ifdef I2C_ASYNC_ENABLE
+// queued transfers, the head is the one on the bus
+static i2c_async_transfer_t* volatile i2c_async_head;
+static i2c_async_transfer_t* volatile i2c_async_tail;
+// finished transfers waiting for i2c_async_task() to run their callback
+static i2c_async_transfer_t* volatile i2c_async_done_head;
+static i2c_async_transfer_t* volatile i2c_async_done_tail;
+// set between i2c_start() and i2c_stop(), the queue waits until the bus is released
+static volatile bool i2c_polled_active;
+
+static void i2c_async_begin(void) {
+    TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+}
+
+static void i2c_async_finish(i2c_async_transfer_t* transfer, i2c_status_t status) {
+    i2c_async_head = transfer->next;
+    if (!i2c_async_head) {
+        i2c_async_tail = NULL;
+    }
+
+    if (transfer->callback) {
+        // stays pending until the callback runs
+        transfer->result = status;
+        transfer->next   = NULL;
+        if (i2c_async_done_tail) {
+            i2c_async_done_tail->next = transfer;
+        } else {
+            i2c_async_done_head = transfer;
+        }
+        i2c_async_done_tail = transfer;
+    } else {
+        transfer->status = status;
+    }
+
+    if (i2c_async_head && !i2c_polled_active) {
+        // STOP, then START for the next transfer as soon as the bus is free
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO) | (1 << TWSTA) | (1 << TWIE);
+    } else {
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+    }
+}
+
+static void i2c_async_read_next(i2c_async_transfer_t* transfer) {
+    if (transfer->rx_length - transfer->index > 1) {
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE) | (1 << TWEA);
+    } else {
+        // NACK the last byte
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+    }
+}
+
+// advances the head transfer by one bus event, called with TWINT set
+static void i2c_async_step(void) {
+    i2c_async_transfer_t* transfer = i2c_async_head;
+    if (!transfer) {
+        TWCR = (1 << TWEN);
+        return;
+    }
+
+    switch (TW_STATUS & 0xF8) {
+        case TW_START:
+        case TW_REP_START:
+            TWDR            = transfer->reading ? (transfer->address | I2C_READ) : (transfer->address & ~I2C_READ);
+            transfer->index = 0;
+            TWCR            = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+            break;
+
+        case TW_MT_SLA_ACK:
+        case TW_MT_DATA_ACK:
+            if (transfer->index < transfer->reg_length) {
+                TWDR = transfer->reg[transfer->index++];
+            } else if (transfer->index - transfer->reg_length < transfer->tx_length) {
+                TWDR = transfer->tx[transfer->index++ - transfer->reg_length];
+            } else if (transfer->rx_length) {
+                // repeated start for the read part
+                transfer->reading = true;
+                TWCR              = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+                break;
+            } else {
+                i2c_async_finish(transfer, I2C_STATUS_SUCCESS);
+                break;
+            }
+            TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+            break;
+
+        case TW_MR_SLA_ACK:
+            i2c_async_read_next(transfer);
+            break;
+
+        case TW_MR_DATA_ACK:
+            transfer->rx[transfer->index++] = TWDR;
+            i2c_async_read_next(transfer);
+            break;
+
+        case TW_MR_DATA_NACK:
+            transfer->rx[transfer->index++] = TWDR;
+            i2c_async_finish(transfer, I2C_STATUS_SUCCESS);
+            break;
+
+        case TW_MT_SLA_NACK:
+        case TW_MR_SLA_NACK:
+            transfer->address_nack = true;
+            i2c_async_finish(transfer, I2C_STATUS_ERROR);
+            break;
+
+        default: // data NACK, lost arbitration, bus error
+            i2c_async_finish(transfer, I2C_STATUS_ERROR);
+            break;
+    }
+}
+
+ISR(TWI_vect) {
+    // TWINT stays set until the step below clears it, so mask the source
+    // before letting other interrupts (V-USB) in. Every step ends with the
+    // TWCR write that re-arms TWIE, which also keeps this from nesting.
+    TWCR &= ~((1 << TWIE) | (1 << TWINT));
+    sei();
+    i2c_async_step();
+}
+
+// waits for a queued transfer, also when called with interrupts disabled
+static bool i2c_async_wait(volatile i2c_status_t* status, uint16_t timeout_timer, uint16_t timeout) {
+    while (*status == I2C_STATUS_PENDING) {
+        if (!(SREG & (1 << SREG_I)) && (TWCR & (1 << TWINT))) {
+            i2c_async_step();
+        }
+        if ((timeout != I2C_TIMEOUT_INFINITE) && (timer_elapsed(timeout_timer) > timeout)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+i2c_status_t i2c_queue_transfer(i2c_async_transfer_t* transfer) {
+    if (transfer->status == I2C_STATUS_PENDING) {
+        return I2C_STATUS_ERROR;
+    }
+
+    transfer->next         = NULL;
+    transfer->index        = 0;
+    transfer->reading      = !transfer->reg_length && !transfer->tx_length && transfer->rx_length;
+    transfer->address_nack = false;
+    transfer->status       = I2C_STATUS_PENDING;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (i2c_async_tail) {
+            i2c_async_tail->next = transfer;
+        } else {
+            i2c_async_head = transfer;
+            if (!i2c_polled_active) {
+                i2c_async_begin();
+            }
+        }
+        i2c_async_tail = transfer;
+    }
+
+    return I2C_STATUS_PENDING;
+}
+
+static i2c_status_t i2c_async_setup(i2c_async_transfer_t* transfer, uint8_t address, const uint8_t* tx, uint16_t tx_length, uint8_t* rx, uint16_t rx_length, i2c_async_callback_t callback) {
+    if (transfer->status == I2C_STATUS_PENDING) {
+        return I2C_STATUS_ERROR;
+    }
+
+    transfer->address    = address;
+    transfer->reg_length = 0;
+    transfer->tx         = tx;
+    transfer->tx_length  = tx_length;
+    transfer->rx         = rx;
+    transfer->rx_length  = rx_length;
+    transfer->callback   = callback;
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_transmit_async(i2c_async_transfer_t* transfer, uint8_t address, const uint8_t* data, uint16_t length, i2c_async_callback_t callback) {
+    if (i2c_async_setup(transfer, address, data, length, NULL, 0, callback) < 0) {
+        return I2C_STATUS_ERROR;
+    }
+    return i2c_queue_transfer(transfer);
+}
+
+i2c_status_t i2c_receive_async(i2c_async_transfer_t* transfer, uint8_t address, uint8_t* data, uint16_t length, i2c_async_callback_t callback) {
+    if (i2c_async_setup(transfer, address, NULL, 0, data, length, callback) < 0) {
+        return I2C_STATUS_ERROR;
+    }
+    return i2c_queue_transfer(transfer);
+}
+
+i2c_status_t i2c_writeReg_async(i2c_async_transfer_t* transfer, uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, i2c_async_callback_t callback) {
+    if (i2c_async_setup(transfer, devaddr, data, length, NULL, 0, callback) < 0) {
+        return I2C_STATUS_ERROR;
+    }
+    transfer->reg[0]     = regaddr;
+    transfer->reg_length = 1;
+    return i2c_queue_transfer(transfer);
+}
+
+i2c_status_t i2c_readReg_async(i2c_async_transfer_t* transfer, uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, i2c_async_callback_t callback) {
+    if (i2c_async_setup(transfer, devaddr, NULL, 0, data, length, callback) < 0) {
+        return I2C_STATUS_ERROR;
+    }
+    transfer->reg[0]     = regaddr;
+    transfer->reg_length = 1;
+    return i2c_queue_transfer(transfer);
+}
+
+i2c_status_t i2c_async_status(const i2c_async_transfer_t* transfer) {
+    return transfer->status;
+}
+
+bool i2c_async_busy(void) {
+    return i2c_async_head != NULL;
+}
+
+void i2c_async_task(void) {
+    while (true) {
+        i2c_async_transfer_t* transfer = NULL;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            transfer = i2c_async_done_head;
+            if (transfer) {
+                i2c_async_done_head = transfer->next;
+                if (!i2c_async_done_head) {
+                    i2c_async_done_tail = NULL;
+                }
+            }
+        }
+        if (!transfer) {
+            break;
+        }
+        transfer->status = transfer->result;
+        transfer->callback(transfer);
+    }
+}
+
+// takes a transfer off a list, false if it is not on it
+static bool i2c_async_unlink(i2c_async_transfer_t* volatile* head, i2c_async_transfer_t* volatile* tail, i2c_async_transfer_t* transfer) {
+    i2c_async_transfer_t* prev = NULL;
+    for (i2c_async_transfer_t* item = *head; item != transfer; item = item->next) {
+        if (!item) {
+            return false;
+        }
+        prev = item;
+    }
+
+    if (prev) {
+        prev->next = transfer->next;
+    } else {
+        *head = transfer->next;
+    }
+    if (*tail == transfer) {
+        *tail = prev;
+    }
+    return true;
+}
+
+// drops a queued transfer, or cuts the one on the bus short with a STOP
+void i2c_async_abort(i2c_async_transfer_t* transfer) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (transfer->status == I2C_STATUS_PENDING) {
+            if (i2c_async_unlink(&i2c_async_done_head, &i2c_async_done_tail, transfer)) {
+                // finished already, only the callback is dropped
+                transfer->status = transfer->result;
+            } else {
+                bool on_bus = transfer == i2c_async_head;
+                i2c_async_unlink(&i2c_async_head, &i2c_async_tail, transfer);
+                if (on_bus) {
+                    if (i2c_async_head && !i2c_polled_active) {
+                        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO) | (1 << TWSTA) | (1 << TWIE);
+                    } else {
+                        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+                    }
+                }
+                transfer->status = I2C_STATUS_TIMEOUT;
+            }
+        }
+    }
+}
+
+// runs a transfer to completion, retrying while the target does not answer its address like i2c_start() does
+static i2c_status_t i2c_transfer_blocking(i2c_async_transfer_t* transfer, uint16_t timeout) {
+    uint16_t timeout_timer = timer_read();
+    do {
+        i2c_queue_transfer(transfer);
+        if (!i2c_async_wait(&transfer->status, timeout_timer, timeout)) {
+            i2c_async_abort(transfer);
+            return transfer->status;
+        }
+    } while (transfer->address_nack && ((timeout == I2C_TIMEOUT_INFINITE) || (timer_elapsed(timeout_timer) <= timeout)));
+
+    return transfer->status;
+}
+
+// holds the queue for a byte level transaction, once whatever is queued has finished
+static i2c_status_t i2c_polled_claim(uint16_t timeout) {
+    uint16_t timeout_timer = timer_read();
+    while (true) {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            if (!i2c_async_head) {
+                i2c_polled_active = true;
+            }
+        }
+        if (i2c_polled_active) {
+            return I2C_STATUS_SUCCESS;
+        }
+        if (!(SREG & (1 << SREG_I)) && (TWCR & (1 << TWINT))) {
+            i2c_async_step();
+        }
+        if ((timeout != I2C_TIMEOUT_INFINITE) && (timer_elapsed(timeout_timer) > timeout)) {
+            return I2C_STATUS_TIMEOUT;
+        }
+    }
+}
+#endif
+
 void i2c_init(void) {
     TWSR = 0; /* no prescaler */
     TWBR = (uint8_t)TWBR_val;
@@ -95,6 +414,12 @@ static i2c_status_t i2c_start_impl(uint8_t address, uint16_t timeout) {
 }
 
 i2c_status_t i2c_start(uint8_t address, uint16_t timeout) {
+#ifdef I2C_ASYNC_ENABLE
+    if (!i2c_polled_active && i2c_polled_claim(timeout) < 0) {
+        return I2C_STATUS_TIMEOUT;
+    }
+#endif
+
     // Retry i2c_start_impl a bunch times in case the remote side has interrupts disabled.
     uint16_t     timeout_timer = timer_read();
     uint16_t     time_slice    = MAX(1, (timeout == (I2C_TIMEOUT_INFINITE)) ? 5 : (timeout / (I2C_START_RETRY_COUNT))); // if it's infinite, wait 1ms between attempts, otherwise split up the entire timeout into the number of retries
@@ -155,6 +480,37 @@ int16_t i2c_read_nack(uint16_t timeout) {
     return TWDR;
 }
 
+#ifdef I2C_ASYNC_ENABLE
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_transfer_t transfer = {.address = address, .tx = data, .tx_length = length};
+    return i2c_transfer_blocking(&transfer, timeout);
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_transfer_t transfer = {.address = address, .rx = data, .rx_length = length};
+    return i2c_transfer_blocking(&transfer, timeout);
+}
+
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_transfer_t transfer = {.address = devaddr, .reg = {regaddr}, .reg_length = 1, .tx = data, .tx_length = length};
+    return i2c_transfer_blocking(&transfer, timeout);
+}
+
+i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_transfer_t transfer = {.address = devaddr, .reg = {regaddr >> 8, regaddr & 0xFF}, .reg_length = 2, .tx = data, .tx_length = length};
+    return i2c_transfer_blocking(&transfer, timeout);
+}
+
+i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_transfer_t transfer = {.address = devaddr, .reg = {regaddr}, .reg_length = 1, .rx = data, .rx_length = length};
+    return i2c_transfer_blocking(&transfer, timeout);
+}
+
+i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_transfer_t transfer = {.address = devaddr, .reg = {regaddr >> 8, regaddr & 0xFF}, .reg_length = 2, .rx = data, .rx_length = length};
+    return i2c_transfer_blocking(&transfer, timeout);
+}
+#else
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
     i2c_status_t status = i2c_start(address | I2C_ACTION_WRITE, timeout);
 
@@ -293,7 +649,24 @@ error:
     return (status < 0) ? status : I2C_STATUS_SUCCESS;
 }
 
+#endif
+
 void i2c_stop(void) {
+#ifdef I2C_ASYNC_ENABLE
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        // leave the bus alone if a queued transfer owns it
+        if (i2c_polled_active || !i2c_async_head) {
+            i2c_polled_active = false;
+            if (i2c_async_head) {
+                // transmit STOP condition, then start the transfers queued meanwhile
+                TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO) | (1 << TWSTA) | (1 << TWIE);
+            } else {
+                TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+            }
+        }
+    }
+#else
     // transmit STOP condition
     TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+#endif
 }
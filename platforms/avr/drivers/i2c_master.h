@@ -20,6 +20,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #define I2C_READ 0x01
 #define I2C_WRITE 0x00
@@ -29,6 +30,7 @@ typedef int16_t i2c_status_t;
 #define I2C_STATUS_SUCCESS (0)
 #define I2C_STATUS_ERROR (-1)
 #define I2C_STATUS_TIMEOUT (-2)
+#define I2C_STATUS_PENDING (-3)
 
 #define I2C_TIMEOUT_IMMEDIATE (0)
 #define I2C_TIMEOUT_INFINITE (0xFFFF)
@@ -45,3 +47,43 @@ i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* da
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 void         i2c_stop(void);
+
+#ifdef I2C_ASYNC_ENABLE
+struct i2c_async_transfer_t;
+typedef void (*i2c_async_callback_t)(struct i2c_async_transfer_t *transfer);
+
+/* A queued transfer. The register bytes and `tx` are written first, then, if
+ * `rx_length` is set, `rx` is read after a repeated start. The descriptor and
+ * its buffers belong to the caller and must stay valid until `status` is no
+ * longer I2C_STATUS_PENDING. The callback runs from i2c_async_task(), and
+ * `status` only changes once it has.
+ */
+typedef struct i2c_async_transfer_t {
+    uint8_t              address;
+    uint8_t              reg[2];
+    uint8_t              reg_length;
+    const uint8_t*       tx;
+    uint16_t             tx_length;
+    uint8_t*             rx;
+    uint16_t             rx_length;
+    i2c_async_callback_t callback;
+    volatile i2c_status_t status;
+
+    /* driver private */
+    struct i2c_async_transfer_t* volatile next;
+    uint16_t                              index;
+    bool                                  reading;
+    bool                                  address_nack;
+    i2c_status_t                          result;
+} i2c_async_transfer_t;
+
+i2c_status_t i2c_queue_transfer(i2c_async_transfer_t* transfer);
+i2c_status_t i2c_transmit_async(i2c_async_transfer_t* transfer, uint8_t address, const uint8_t* data, uint16_t length, i2c_async_callback_t callback);
+i2c_status_t i2c_receive_async(i2c_async_transfer_t* transfer, uint8_t address, uint8_t* data, uint16_t length, i2c_async_callback_t callback);
+i2c_status_t i2c_writeReg_async(i2c_async_transfer_t* transfer, uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, i2c_async_callback_t callback);
+i2c_status_t i2c_readReg_async(i2c_async_transfer_t* transfer, uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, i2c_async_callback_t callback);
+i2c_status_t i2c_async_status(const i2c_async_transfer_t* transfer);
+void         i2c_async_abort(i2c_async_transfer_t* transfer);
+bool         i2c_async_busy(void);
+void         i2c_async_task(void);
+#endif
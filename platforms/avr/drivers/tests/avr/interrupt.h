@@ -0,0 +1,13 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <avr/io.h>
+
+#define TWI_vect mock_twi_vect
+#define ISR(vector, ...) void vector(void)
+
+void mock_twi_vect(void);
+
+#define sei() (SREG |= (1 << SREG_I))
+#define cli() (SREG &= ~(1 << SREG_I))
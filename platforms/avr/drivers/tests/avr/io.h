@@ -0,0 +1,32 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/* Just enough of the ATmega TWI and status registers for i2c_master.c. TWCR
+ * and SREG go through the bus simulation in mock_twi.c on every access.
+ */
+
+#include <stdint.h>
+
+extern volatile uint8_t mock_twcr_reg;
+extern volatile uint8_t mock_sreg_reg;
+extern volatile uint8_t TWSR;
+extern volatile uint8_t TWDR;
+extern volatile uint8_t TWBR;
+extern volatile uint8_t PORTC;
+
+volatile uint8_t *mock_twcr(void);
+volatile uint8_t *mock_sreg(void);
+
+#define TWCR (*mock_twcr())
+#define SREG (*mock_sreg())
+
+#define TWINT 7
+#define TWEA 6
+#define TWSTA 5
+#define TWSTO 4
+#define TWWC 3
+#define TWEN 2
+#define TWIE 0
+
+#define SREG_I 7
@@ -0,0 +1,191 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include <avr/io.h>
+#include "i2c_master.h"
+#include "mock_twi.h"
+#include "timer.h"
+}
+
+static uint8_t      callback_count;
+static i2c_status_t callback_status;
+
+static void count_callback(i2c_async_transfer_t* transfer) {
+    callback_count++;
+    callback_status = transfer->status;
+}
+
+class I2cAsyncTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_twi_reset();
+        timer_clear();
+        callback_count  = 0;
+        callback_status = I2C_STATUS_PENDING;
+    }
+
+    void interrupts(bool enabled) {
+        if (enabled) {
+            SREG |= (1 << SREG_I);
+        } else {
+            SREG &= ~(1 << SREG_I);
+        }
+    }
+
+    const uint8_t data[3] = {0x05, 0x11, 0x22};
+};
+
+TEST_F(I2cAsyncTest, TransmitRunsFromTheInterrupt) {
+    i2c_async_transfer_t transfer = {};
+
+    EXPECT_EQ(i2c_transmit_async(&transfer, MOCK_TWI_ADDRESS, data, sizeof(data), NULL), I2C_STATUS_PENDING);
+    EXPECT_TRUE(i2c_async_busy());
+    mock_twi_run();
+
+    EXPECT_FALSE(i2c_async_busy());
+    EXPECT_EQ(i2c_async_status(&transfer), I2C_STATUS_SUCCESS);
+    EXPECT_STREQ(mock_twi_trace, "S @A0 05 11 22 P");
+    EXPECT_EQ(mock_twi_memory[5], 0x11);
+    EXPECT_EQ(mock_twi_memory[6], 0x22);
+}
+
+TEST_F(I2cAsyncTest, ReadRegUsesARepeatedStart) {
+    i2c_async_transfer_t transfer = {};
+    uint8_t              rx[3]    = {};
+
+    mock_twi_memory[2] = 0x10;
+    mock_twi_memory[3] = 0x20;
+    mock_twi_memory[4] = 0x30;
+    EXPECT_EQ(i2c_readReg_async(&transfer, MOCK_TWI_ADDRESS, 2, rx, sizeof(rx), NULL), I2C_STATUS_PENDING);
+    mock_twi_run();
+
+    EXPECT_EQ(i2c_async_status(&transfer), I2C_STATUS_SUCCESS);
+    EXPECT_STREQ(mock_twi_trace, "S @A0 02 S @A1 <10 <20 <30 P");
+    EXPECT_EQ(rx[0], 0x10);
+    EXPECT_EQ(rx[2], 0x30);
+}
+
+TEST_F(I2cAsyncTest, QueuedTransfersRunInOrder) {
+    i2c_async_transfer_t first  = {};
+    i2c_async_transfer_t second = {};
+    uint8_t              rx     = 0;
+
+    i2c_transmit_async(&first, MOCK_TWI_ADDRESS, data, 2, NULL);
+    i2c_readReg_async(&second, MOCK_TWI_ADDRESS, 5, &rx, 1, NULL);
+    EXPECT_EQ(i2c_transmit_async(&first, MOCK_TWI_ADDRESS, data, 2, NULL), I2C_STATUS_ERROR);
+    mock_twi_run();
+
+    EXPECT_EQ(i2c_async_status(&first), I2C_STATUS_SUCCESS);
+    EXPECT_EQ(i2c_async_status(&second), I2C_STATUS_SUCCESS);
+    EXPECT_STREQ(mock_twi_trace, "S @A0 05 11 P S @A0 05 S @A1 <11 P");
+}
+
+TEST_F(I2cAsyncTest, CallbackRunsFromTheTask) {
+    i2c_async_transfer_t transfer = {};
+
+    i2c_transmit_async(&transfer, MOCK_TWI_ADDRESS, data, sizeof(data), count_callback);
+    mock_twi_run();
+
+    // the bus is done, but nothing has run in interrupt context
+    EXPECT_FALSE(i2c_async_busy());
+    EXPECT_EQ(callback_count, 0);
+    EXPECT_EQ(i2c_async_status(&transfer), I2C_STATUS_PENDING);
+
+    i2c_async_task();
+    EXPECT_EQ(callback_count, 1);
+    EXPECT_EQ(callback_status, I2C_STATUS_SUCCESS);
+    EXPECT_EQ(i2c_async_status(&transfer), I2C_STATUS_SUCCESS);
+
+    i2c_async_task();
+    EXPECT_EQ(callback_count, 1);
+}
+
+TEST_F(I2cAsyncTest, AddressNackFailsTheTransfer) {
+    i2c_async_transfer_t transfer = {};
+
+    mock_twi_absent = true;
+    i2c_transmit_async(&transfer, MOCK_TWI_ADDRESS, data, sizeof(data), count_callback);
+    mock_twi_run();
+    i2c_async_task();
+
+    EXPECT_EQ(callback_status, I2C_STATUS_ERROR);
+    EXPECT_TRUE(transfer.address_nack);
+    EXPECT_STREQ(mock_twi_trace, "S @A0 P");
+}
+
+TEST_F(I2cAsyncTest, BlockingTransmitRetriesTheAddress) {
+    mock_twi_address_nacks = 2;
+
+    EXPECT_EQ(i2c_transmit(MOCK_TWI_ADDRESS, data, 2, 100), I2C_STATUS_SUCCESS);
+    mock_twi_run();
+    EXPECT_STREQ(mock_twi_trace, "S @A0 P S @A0 P S @A0 05 11 P");
+}
+
+TEST_F(I2cAsyncTest, BlockingTransmitGivesUpAtTheTimeout) {
+    mock_twi_absent = true;
+
+    EXPECT_EQ(i2c_transmit(MOCK_TWI_ADDRESS, data, 2, 5), I2C_STATUS_ERROR);
+    EXPECT_LE(mock_twi_starts, 7);
+    EXPECT_FALSE(i2c_async_busy());
+}
+
+TEST_F(I2cAsyncTest, BlockingTransferWithInterruptsDisabled) {
+    uint8_t rx[2] = {};
+
+    mock_twi_memory[7] = 0x77;
+    interrupts(false);
+    EXPECT_EQ(i2c_readReg(MOCK_TWI_ADDRESS, 6, rx, sizeof(rx), 100), I2C_STATUS_SUCCESS);
+    interrupts(true);
+
+    EXPECT_EQ(rx[1], 0x77);
+    EXPECT_STREQ(mock_twi_trace, "S @A0 06 S @A1 <00 <77 P");
+}
+
+TEST_F(I2cAsyncTest, QueueWaitsForAPolledSession) {
+    i2c_async_transfer_t transfer = {};
+
+    EXPECT_EQ(i2c_start(MOCK_TWI_ADDRESS, 100), I2C_STATUS_SUCCESS);
+    i2c_transmit_async(&transfer, MOCK_TWI_ADDRESS, data, 2, NULL);
+    mock_twi_run();
+    EXPECT_EQ(i2c_async_status(&transfer), I2C_STATUS_PENDING);
+
+    EXPECT_EQ(i2c_write(0x09, 100), I2C_STATUS_SUCCESS);
+    i2c_stop();
+    mock_twi_run();
+
+    EXPECT_EQ(i2c_async_status(&transfer), I2C_STATUS_SUCCESS);
+    EXPECT_STREQ(mock_twi_trace, "S @A0 09 P S @A0 05 11 P");
+}
+
+TEST_F(I2cAsyncTest, AbortStopsTheTransferOnTheBus) {
+    i2c_async_transfer_t first  = {};
+    i2c_async_transfer_t second = {};
+
+    interrupts(false);
+    i2c_transmit_async(&first, MOCK_TWI_ADDRESS, data, sizeof(data), count_callback);
+    i2c_transmit_async(&second, MOCK_TWI_ADDRESS, data, 1, NULL);
+    i2c_async_abort(&first);
+    interrupts(true);
+    mock_twi_run();
+    i2c_async_task();
+
+    EXPECT_EQ(i2c_async_status(&first), I2C_STATUS_TIMEOUT);
+    EXPECT_EQ(i2c_async_status(&second), I2C_STATUS_SUCCESS);
+    EXPECT_EQ(callback_count, 0);
+    EXPECT_STREQ(mock_twi_trace, "S P S @A0 05 P");
+}
+
+TEST_F(I2cAsyncTest, AbortAfterCompletionDropsTheCallback) {
+    i2c_async_transfer_t transfer = {};
+
+    i2c_transmit_async(&transfer, MOCK_TWI_ADDRESS, data, sizeof(data), count_callback);
+    mock_twi_run();
+    i2c_async_abort(&transfer);
+    i2c_async_task();
+
+    EXPECT_EQ(callback_count, 0);
+    EXPECT_EQ(i2c_async_status(&transfer), I2C_STATUS_SUCCESS);
+}
@@ -0,0 +1,163 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdio.h>
+#include <string.h>
+#include <avr/interrupt.h>
+#include <util/twi.h>
+#include "mock_twi.h"
+#include "timer.h"
+
+// bit 1 of TWCR is reserved, the simulation uses it to spot writes
+#define TWCR_UNTOUCHED (1 << 1)
+
+// platforms/test/timer.c
+void advance_time(uint32_t ms);
+
+volatile uint8_t mock_twcr_reg;
+volatile uint8_t mock_sreg_reg;
+volatile uint8_t TWSR;
+volatile uint8_t TWDR;
+volatile uint8_t TWBR;
+volatile uint8_t PORTC;
+
+char    mock_twi_trace[MOCK_TWI_TRACE_MAX];
+uint8_t mock_twi_memory[16];
+uint8_t mock_twi_address_nacks;
+bool    mock_twi_absent;
+uint8_t mock_twi_starts;
+
+static uint8_t twcr_left;
+static bool    twint;
+static bool    bus_owned;
+static bool    pointer_set;
+static uint8_t pointer;
+static bool    in_tick;
+
+static void trace(const char *format, uint8_t value) {
+    size_t length = strlen(mock_twi_trace);
+    snprintf(mock_twi_trace + length, sizeof(mock_twi_trace) - length, "%s", length ? " " : "");
+    length = strlen(mock_twi_trace);
+    snprintf(mock_twi_trace + length, sizeof(mock_twi_trace) - length, format, value);
+}
+
+// what the TWI hardware does once TWINT is written
+static void twi_command(uint8_t command) {
+    if (command & (1 << TWSTO)) {
+        if (bus_owned) {
+            trace("%c", 'P');
+        }
+        bus_owned = false;
+        TWSR      = TW_NO_INFO;
+        if (!(command & (1 << TWSTA))) {
+            return;
+        }
+    }
+
+    if (command & (1 << TWSTA)) {
+        trace("%c", 'S');
+        TWSR      = bus_owned ? TW_REP_START : TW_START;
+        bus_owned = true;
+        twint     = true;
+        mock_twi_starts++;
+        // a start and an address take a millisecond, so that timeouts expire
+        advance_time(1);
+        return;
+    }
+
+    if (!bus_owned) {
+        return;
+    }
+
+    bool reading = TWDR & TW_READ;
+    switch (TWSR) {
+        case TW_START:
+        case TW_REP_START:
+            trace("@%02X", TWDR);
+            if (mock_twi_absent || mock_twi_address_nacks || (TWDR & ~TW_READ) != MOCK_TWI_ADDRESS) {
+                if (mock_twi_address_nacks) {
+                    mock_twi_address_nacks--;
+                }
+                TWSR = reading ? TW_MR_SLA_NACK : TW_MT_SLA_NACK;
+            } else {
+                TWSR        = reading ? TW_MR_SLA_ACK : TW_MT_SLA_ACK;
+                pointer_set = false;
+            }
+            break;
+
+        case TW_MT_SLA_ACK:
+        case TW_MT_DATA_ACK:
+            trace("%02X", TWDR);
+            if (pointer_set) {
+                mock_twi_memory[pointer++ % sizeof(mock_twi_memory)] = TWDR;
+            } else {
+                pointer     = TWDR;
+                pointer_set = true;
+            }
+            TWSR = TW_MT_DATA_ACK;
+            break;
+
+        case TW_MR_SLA_ACK:
+        case TW_MR_DATA_ACK:
+            TWDR = mock_twi_memory[pointer++ % sizeof(mock_twi_memory)];
+            trace("<%02X", TWDR);
+            TWSR = (command & (1 << TWEA)) ? TW_MR_DATA_ACK : TW_MR_DATA_NACK;
+            break;
+
+        default:
+            // only a STOP or START gets the bus going again
+            return;
+    }
+    twint = true;
+}
+
+static void twi_tick(void) {
+    if (in_tick) {
+        return;
+    }
+    in_tick = true;
+
+    uint8_t written = mock_twcr_reg & ~TWCR_UNTOUCHED;
+    if (mock_twcr_reg != twcr_left && (written & (1 << TWINT))) {
+        twint = false;
+        twi_command(written);
+    }
+    written &= ~((1 << TWINT) | (1 << TWSTO));
+    mock_twcr_reg = twcr_left = written | (twint ? (1 << TWINT) : 0) | TWCR_UNTOUCHED;
+
+    in_tick = false;
+
+    if (twint && (written & (1 << TWIE)) && (mock_sreg_reg & (1 << SREG_I))) {
+        mock_sreg_reg &= ~(1 << SREG_I);
+        mock_twi_vect();
+        mock_sreg_reg |= (1 << SREG_I);
+    }
+}
+
+volatile uint8_t *mock_twcr(void) {
+    twi_tick();
+    return &mock_twcr_reg;
+}
+
+volatile uint8_t *mock_sreg(void) {
+    twi_tick();
+    return &mock_sreg_reg;
+}
+
+void mock_twi_reset(void) {
+    mock_twcr_reg = twcr_left = TWCR_UNTOUCHED;
+    mock_sreg_reg             = 1 << SREG_I;
+    twint                     = false;
+    bus_owned                 = false;
+    mock_twi_trace[0]         = '\0';
+    mock_twi_address_nacks    = 0;
+    mock_twi_absent           = false;
+    mock_twi_starts           = 0;
+    memset(mock_twi_memory, 0, sizeof(mock_twi_memory));
+}
+
+void mock_twi_run(void) {
+    for (int i = 0; i < 1000; i++) {
+        twi_tick();
+    }
+}
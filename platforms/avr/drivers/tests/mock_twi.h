@@ -0,0 +1,24 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* One target on the bus, a 16 byte memory behind a register pointer that the
+ * first written byte sets. Every bus event is appended to the trace: "S" start,
+ * "@A0" address, "05" written byte, "<10" read byte, "P" stop.
+ */
+#define MOCK_TWI_ADDRESS 0xA0
+#define MOCK_TWI_TRACE_MAX 512
+
+extern char    mock_twi_trace[MOCK_TWI_TRACE_MAX];
+extern uint8_t mock_twi_memory[16];
+// the target NACKs this many address phases, or all of them while absent
+extern uint8_t mock_twi_address_nacks;
+extern bool    mock_twi_absent;
+extern uint8_t mock_twi_starts;
+
+void mock_twi_reset(void);
+// lets the bus run until nothing is left to do
+void mock_twi_run(void);
@@ -0,0 +1,10 @@
+i2c_master_async_DEFS := -DI2C_ASYNC_ENABLE -DF_CPU=16000000UL
+i2c_master_async_INC := \
+	$(PLATFORM_PATH)/avr/drivers/tests \
+	$(PLATFORM_PATH)/avr/drivers
+
+i2c_master_async_SRC := \
+	$(PLATFORM_PATH)/avr/drivers/tests/mock_twi.c \
+	$(PLATFORM_PATH)/avr/drivers/tests/i2c_master_tests.cpp \
+	$(PLATFORM_PATH)/avr/drivers/i2c_master.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
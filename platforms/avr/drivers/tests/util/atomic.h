@@ -0,0 +1,18 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <avr/io.h>
+
+static inline uint8_t mock_atomic_start(void) {
+    uint8_t sreg = SREG;
+    SREG         = sreg & ~(1 << SREG_I);
+    return 1;
+}
+
+static inline void mock_atomic_restore(const uint8_t *sreg) {
+    SREG = *sreg;
+}
+
+#define ATOMIC_RESTORESTATE uint8_t mock_sreg_save __attribute__((__cleanup__(mock_atomic_restore))) = SREG
+#define ATOMIC_BLOCK(type) for (type, mock_atomic_todo = mock_atomic_start(); mock_atomic_todo; mock_atomic_todo = 0)
@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <avr/sleep.h>
 #include "platform_deps.h"
 
 static void disable_jtag(void) {
@@ -30,3 +31,9 @@ static void disable_jtag(void) {
 void platform_setup(void) {
     disable_jtag();
 }
+
+void keyboard_idle_sleep(void) {
+    // woken by any interrupt: the timer tick, USB or a pin change
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode();
+}
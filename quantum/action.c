@@ -31,6 +31,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "keycode_config.h"
 #include "debug.h"
 #include "quantum.h"
+#include "task_profiler.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -66,6 +67,39 @@ __attribute__((weak)) bool get_retro_tapping(uint16_t keycode, keyrecord_t *reco
 }
 #endif
 
+static uint16_t action_deadlines[ACTION_DEADLINE_COUNT];
+static uint8_t  action_deadlines_set = 0;
+
+/** \brief Sets the time from which an owner needs tick events.
+ */
+void action_deadline_set(action_deadline_t owner, uint16_t time) {
+    action_deadlines[owner] = time;
+    action_deadlines_set |= 1 << owner;
+}
+
+/** \brief Clears the deadline of an owner, it needs no more tick events.
+ */
+void action_deadline_clear(action_deadline_t owner) {
+    action_deadlines_set &= ~(1 << owner);
+}
+
+/** \brief Whether any owner is waiting for a deadline.
+ */
+bool action_deadline_pending(void) {
+    return action_deadlines_set != 0;
+}
+
+/** \brief Whether any deadline has been reached by now.
+ */
+bool action_deadline_expired(uint16_t now) {
+    for (uint8_t owner = 0; owner < ACTION_DEADLINE_COUNT; owner++) {
+        if ((action_deadlines_set & (1 << owner)) && timer_expired(now, action_deadlines[owner])) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /** \brief Called to execute an action.
  *
  * FIXME: Needs documentation.
@@ -132,6 +166,10 @@ void action_exec(keyevent_t event) {
         dprintln();
     }
 #endif
+
+#ifndef NO_ACTION_ONESHOT
+    update_oneshot_deadline();
+#endif
 }
 
 #ifdef SWAP_HANDS_ENABLE
@@ -270,6 +308,7 @@ void process_record(keyrecord_t *record) {
     if (IS_NOEVENT(record->event)) {
         return;
     }
+    task_profiler_key_event(&record->event);
 
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
@@ -918,7 +957,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
         // Force a new key press if the key is already pressed
         // without this, keys with the same keycode, but different
         // modifiers will be reported incorrectly, see issue #1708
-        if (is_key_pressed(keyboard_report, code)) {
+        if (has_key(code)) {
             del_key(code);
             send_keyboard_report();
         }
@@ -1011,10 +1050,27 @@ __attribute__((weak)) void tap_code_delay(uint8_t code, uint16_t delay) {
 }
 
 /** \brief Tap a keycode with the default delay.
+ *
+ * With `EXTRA_TAP_QUEUE_ENABLE`, system and consumer keycodes are queued and released one USB poll interval
+ * later, without waiting for `TAP_CODE_DELAY`. Other keycodes are tapped after the queued ones.
  *
  * \param code The basic keycode to tap. If `code` is `KC_CAPS_LOCK`, the delay will be `TAP_HOLD_CAPS_DELAY`, otherwise `TAP_CODE_DELAY`, if defined.
  */
 __attribute__((weak)) void tap_code(uint8_t code) {
+#if defined(EXTRAKEY_ENABLE) && defined(EXTRA_TAP_QUEUE_ENABLE)
+    if (IS_SYSTEM_KEYCODE(code) || IS_CONSUMER_KEYCODE(code)) {
+        // a full queue is waited on at its pace, the taps keep their order
+        while (!(IS_SYSTEM_KEYCODE(code) ? host_system_tap(KEYCODE2SYSTEM(code)) : host_consumer_tap(KEYCODE2CONSUMER(code)))) {
+            wait_ms(1);
+            host_extra_task();
+        }
+        return;
+    }
+    while (host_extra_tap_pending()) {
+        wait_ms(1);
+        host_extra_task();
+    }
+#endif
     tap_code_delay(code, code == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
 }
 
@@ -58,6 +58,21 @@ typedef struct {
 /* Execute action per keyevent */
 void action_exec(keyevent_t event);
 
+/* Deadlines of the timed states driven by tick events. Tick events are only generated
+ * once a deadline has expired, see TICK_EVENT_EVERY_MS. An owner sets its deadline
+ * whenever its state is armed and updates it after every action_exec(), an early
+ * deadline only costs extra ticks. */
+typedef enum {
+    ACTION_DEADLINE_TAPPING,
+    ACTION_DEADLINE_ONESHOT,
+    ACTION_DEADLINE_COUNT,
+} action_deadline_t;
+
+void action_deadline_set(action_deadline_t owner, uint16_t time);
+void action_deadline_clear(action_deadline_t owner);
+bool action_deadline_pending(void);
+bool action_deadline_expired(uint16_t now);
+
 /* action for key */
 action_t action_for_key(uint8_t layer, keypos_t key);
 action_t action_for_keycode(uint16_t keycode);
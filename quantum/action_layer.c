@@ -7,6 +7,12 @@
 #include "util.h"
 #include "action_layer.h"
 
+#if defined(RESOLVED_LAYER_TABLE) && !defined(NO_ACTION_LAYER)
+static void resolved_layer_table_update(void);
+#else
+#    define resolved_layer_table_update()
+#endif
+
 /** \brief Default Layer State
  */
 layer_state_t default_layer_state = 0;
@@ -37,6 +43,7 @@ static void default_layer_state_set(layer_state_t state) {
     default_layer_debug();
     ac_dprintf(" to ");
     default_layer_state = state;
+    resolved_layer_table_update();
     default_layer_debug();
     ac_dprintf("\n");
 #if defined(STRICT_LAYER_RELEASE)
@@ -117,6 +124,7 @@ void layer_state_set(layer_state_t state) {
     layer_debug();
     ac_dprintf(" to ");
     layer_state = state;
+    resolved_layer_table_update();
     layer_debug();
     ac_dprintf("\n");
 #    if defined(STRICT_LAYER_RELEASE)
@@ -316,27 +324,101 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Layer scan
  *
- * Gets the layer based on key info
+ * Returns the topmost layer in layers where key is not transparent, or -1 if there is none
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
-
-    layer_state_t layers = layer_state | default_layer_state;
+static int8_t layer_scan(keypos_t key, layer_state_t layers) {
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
+            if (action_for_key(i, key).code != ACTION_TRANSPARENT) {
                 return i;
             }
         }
     }
+    return -1;
+}
+#endif
+
+#if defined(RESOLVED_LAYER_TABLE) && !defined(NO_ACTION_LAYER)
+/** \brief resolved layer table
+ *
+ * The layer layer_switch_get_layer() returns for every matrix position, valid for resolved_layers
+ */
+static uint8_t       resolved_layer_table[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t resolved_layers;
+static bool          resolved_layer_table_valid = false;
+
+/** \brief Resolved layer table invalidate
+ *
+ * Forces a full rebuild on the next lookup, to be called when the keymap contents change
+ */
+void resolved_layer_table_invalidate(void) {
+    resolved_layer_table_valid = false;
+}
+
+/** \brief Resolved layer table update
+ *
+ * Brings the table in line with the current layer stack. Only the layers switched
+ * on or off since the last update are looked at: a key can only move up to a
+ * layer that was switched on above it, and only a key whose layer was switched
+ * off has to scan the layers below it again.
+ */
+static void resolved_layer_table_update(void) {
+    layer_state_t layers = layer_state | default_layer_state;
+
+    if (resolved_layer_table_valid && layers == resolved_layers) {
+        return;
+    }
+
+    layer_state_t added   = resolved_layer_table_valid ? layers & ~resolved_layers : layers;
+    layer_state_t removed = resolved_layer_table_valid ? resolved_layers & ~layers : 0;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t      key   = {.row = row, .col = col};
+            uint8_t       layer = resolved_layer_table_valid ? resolved_layer_table[row][col] : 0;
+            layer_state_t below = ((layer_state_t)1 << layer) - 1;
+            layer_state_t scan  = added & ~below & ~((layer_state_t)1 << layer);
+            bool          lost  = removed & ((layer_state_t)1 << layer);
+
+            if (lost) {
+                scan |= layers & below;
+            }
+            int8_t found = scan ? layer_scan(key, scan) : -1;
+            if (found >= 0) {
+                resolved_layer_table[row][col] = found;
+            } else if (lost || !resolved_layer_table_valid) {
+                /* fall back to layer 0 */
+                resolved_layer_table[row][col] = 0;
+            }
+        }
+    }
+
+    resolved_layers            = layers;
+    resolved_layer_table_valid = true;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+#    ifdef RESOLVED_LAYER_TABLE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        /* catches up on layer state written without layer_state_set() */
+        resolved_layer_table_update();
+        return resolved_layer_table[key.row][key.col];
+    }
+#    endif
+
+    int8_t layer = layer_scan(key, layer_state | default_layer_state);
     /* fall back to layer 0 */
-    return 0;
+    return layer < 0 ? 0 : layer;
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -165,5 +165,12 @@ action_t store_or_get_action(bool pressed, keypos_t key);
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
+#if defined(RESOLVED_LAYER_TABLE) && !defined(NO_ACTION_LAYER)
+/* rebuild the per key layer table used by layer_switch_get_layer() after the keymap changed */
+void resolved_layer_table_invalidate(void);
+#else
+#    define resolved_layer_table_invalidate()
+#endif
+
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
@@ -0,0 +1,19 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "action_layer_mock.h"
+#include "action.h"
+#include "keycodes.h"
+
+uint16_t mock_keymap[MAX_LAYER][MATRIX_ROWS][MATRIX_COLS];
+uint32_t mock_action_lookups = 0;
+
+bool disable_action_cache = false;
+
+action_t action_for_key(uint8_t layer, keypos_t key) {
+    mock_action_lookups++;
+    uint16_t keycode = mock_keymap[layer][key.row][key.col];
+    action_t action;
+    action.code = keycode == KC_TRANSPARENT ? ACTION_TRANSPARENT : ACTION_KEY(keycode);
+    return action;
+}
@@ -0,0 +1,13 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "action_layer.h"
+
+// Keycodes returned by action_for_key(), KC_TRANSPARENT keys fall through
+extern uint16_t mock_keymap[MAX_LAYER][MATRIX_ROWS][MATRIX_COLS];
+
+// action_for_key() calls since the last reset
+extern uint32_t mock_action_lookups;
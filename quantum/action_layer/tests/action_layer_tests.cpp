@@ -0,0 +1,164 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "action_layer.h"
+#include "action_layer_mock.h"
+#include "keycodes.h"
+}
+
+class ActionLayer : public ::testing::Test {
+   protected:
+    std::mt19937 rng{0x51C0FFEE};
+
+    void SetUp() override {
+        layer_state         = 0;
+        default_layer_state = 0;
+        for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    mock_keymap[layer][row][col] = random_keycode(layer);
+                }
+            }
+        }
+        resolved_layer_table_invalidate();
+        mock_action_lookups = 0;
+    }
+
+    // Layer 0 is mostly mapped, higher layers mostly transparent
+    uint16_t random_keycode(uint8_t layer) {
+        uint32_t percent_mapped = layer == 0 ? 90 : 25;
+        return rng() % 100 < percent_mapped ? KC_A + rng() % 26 : KC_TRANSPARENT;
+    }
+
+    uint8_t random_layer() {
+        return rng() % MAX_LAYER;
+    }
+
+    layer_state_t random_state() {
+        // a handful of layers at most, like a real layer stack
+        layer_state_t state = 0;
+        for (uint8_t i = rng() % 4; i > 0; i--) {
+            state |= (layer_state_t)1 << random_layer();
+        }
+        return state;
+    }
+
+    // The scan layer_switch_get_layer() did before the table
+    static uint8_t slow_path_layer(keypos_t key) {
+        layer_state_t layers = layer_state | default_layer_state;
+        for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+            if (layers & ((layer_state_t)1 << i)) {
+                if (action_for_key(i, key).code != ACTION_TRANSPARENT) {
+                    return i;
+                }
+            }
+        }
+        return 0;
+    }
+
+    void expect_matches_slow_path(int step) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = {.col = col, .row = row};
+                ASSERT_EQ(layer_switch_get_layer(key), slow_path_layer(key)) << "step " << step << " row " << +row << " col " << +col << " layer_state " << layer_state << " default_layer_state " << default_layer_state;
+            }
+        }
+    }
+};
+
+TEST_F(ActionLayer, FuzzLayerTransitions) {
+    for (int step = 0; step < 20000; step++) {
+        switch (rng() % 12) {
+            case 0:
+            case 1:
+                layer_on(random_layer());
+                break;
+            case 2:
+            case 3:
+                layer_off(random_layer());
+                break;
+            case 4:
+                layer_invert(random_layer());
+                break;
+            case 5:
+                layer_move(random_layer());
+                break;
+            case 6:
+                layer_clear();
+                break;
+            case 7:
+                switch (rng() % 3) {
+                    case 0:
+                        layer_or(random_state());
+                        break;
+                    case 1:
+                        layer_and(random_state());
+                        break;
+                    default:
+                        layer_xor(random_state());
+                        break;
+                }
+                break;
+            case 8:
+                default_layer_set((layer_state_t)1 << random_layer());
+                break;
+            case 9:
+                // bypassing layer_state_set() must not leave the table stale
+                layer_state = random_state();
+                break;
+            case 10: {
+                uint8_t layer = random_layer();
+                uint8_t row   = rng() % MATRIX_ROWS;
+                uint8_t col   = rng() % MATRIX_COLS;
+
+                mock_keymap[layer][row][col] = random_keycode(layer);
+                resolved_layer_table_invalidate();
+                break;
+            }
+            default:
+                layer_state_set(random_state());
+                break;
+        }
+        expect_matches_slow_path(step);
+    }
+}
+
+TEST_F(ActionLayer, LookupIsConstantTime) {
+    layer_on(1);
+    layer_on(MAX_LAYER - 1);
+    mock_action_lookups = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            layer_switch_get_layer((keypos_t){.col = col, .row = row});
+        }
+    }
+    EXPECT_EQ(mock_action_lookups, 0);
+}
+
+TEST_F(ActionLayer, LayerOnLooksAtNewLayerOnly) {
+    layer_on(1);
+    layer_switch_get_layer((keypos_t){.col = 0, .row = 0});
+    mock_action_lookups = 0;
+
+    // a layer on top of the stack costs one lookup per key to resolve
+    layer_on(MAX_LAYER - 1);
+    EXPECT_EQ(mock_action_lookups, MATRIX_ROWS * MATRIX_COLS);
+}
+
+TEST_F(ActionLayer, SourceLayersCacheKeepsPressLayer) {
+    keypos_t key = {.col = 2, .row = 1};
+
+    mock_keymap[0][1][2] = KC_A;
+    mock_keymap[3][1][2] = KC_B;
+    resolved_layer_table_invalidate();
+
+    layer_on(3);
+    EXPECT_EQ(store_or_get_action(true, key).code, ACTION_KEY(KC_B));
+    layer_off(3);
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+    EXPECT_EQ(store_or_get_action(false, key).code, ACTION_KEY(KC_B));
+}
@@ -0,0 +1,17 @@
+# The resolved layer table is fuzzed against a plain scan of the layer stack, once
+# with the default 16 bit layer state and once with all 32 layers.
+
+action_layer_DEFS := \
+	-DMATRIX_ROWS=4 \
+	-DMATRIX_COLS=6 \
+	-DRESOLVED_LAYER_TABLE \
+	-DNO_PRINT \
+	-DNO_DEBUG
+
+action_layer_SRC := \
+	$(QUANTUM_PATH)/action_layer/tests/action_layer_mock.c \
+	$(QUANTUM_PATH)/action_layer/tests/action_layer_tests.cpp \
+	$(QUANTUM_PATH)/action_layer.c
+
+action_layer_32bit_DEFS := $(action_layer_DEFS) -DLAYER_STATE_32BIT
+action_layer_32bit_SRC := $(action_layer_SRC)
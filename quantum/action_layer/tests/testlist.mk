@@ -0,0 +1 @@
+TEST_LIST += action_layer action_layer_32bit
@@ -5,6 +5,7 @@
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
 
 #ifndef NO_ACTION_TAPPING
@@ -64,12 +65,25 @@ static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+/* Every queued event also sets the bit of its key in the pressed or released map, so
+ * the buffer is asked about a key without walking it. A key queued twice the same way
+ * counts as a repeat, only dequeueing a repeat looks for the other copies. Events off
+ * the matrix, like encoders, are counted and looked up by walking the buffer.
+ */
+static matrix_row_t waiting_buffer_pressed[MATRIX_ROWS]  = {};
+static matrix_row_t waiting_buffer_released[MATRIX_ROWS] = {};
+static uint8_t      waiting_buffer_presses               = 0;
+static uint8_t      waiting_buffer_repeats               = 0;
+static uint8_t      waiting_buffer_off_matrix            = 0;
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
-static void waiting_buffer_clear(void);
+static void waiting_buffer_deq(void);
+static void waiting_buffer_make_room(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
+static void update_tapping_deadline(void);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
@@ -86,11 +100,8 @@ void action_tapping_process(keyrecord_t record) {
         }
     } else {
         if (!waiting_buffer_enq(record)) {
-            // clear all in case of overflow.
-            ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
-            clear_keyboard();
-            waiting_buffer_clear();
-            tapping_key = (keyrecord_t){0};
+            waiting_buffer_make_room();
+            waiting_buffer_enq(record);
         }
     }
 
@@ -98,18 +109,39 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
-            debug_record(waiting_buffer[waiting_buffer_tail]);
-            ac_dprintf("\n\n");
-        } else {
+    while (waiting_buffer_tail != waiting_buffer_head) {
+        if (!process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             break;
         }
+        ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
+        debug_record(waiting_buffer[waiting_buffer_tail]);
+        ac_dprintf("\n\n");
+        waiting_buffer_deq();
     }
     if (IS_EVENT(record.event)) {
         ac_dprintf("\n");
     }
+
+    update_tapping_deadline();
+}
+
+/** \brief Update tapping deadline
+ *
+ * A tapping key is decided by the first tick event past its tapping term, the ticks
+ * before only return early. A tapping key held after a tap waits for its release.
+ */
+static void update_tapping_deadline(void) {
+    if (IS_NOEVENT(tapping_key.event)) {
+        action_deadline_clear(ACTION_DEADLINE_TAPPING);
+        return;
+    }
+
+    uint16_t deadline = tapping_key.event.time + GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+    if (tapping_key.event.pressed && tapping_key.tap.count > 0 && timer_expired(timer_read(), deadline)) {
+        action_deadline_clear(ACTION_DEADLINE_TAPPING);
+    } else {
+        action_deadline_set(ACTION_DEADLINE_TAPPING, deadline);
+    }
 }
 
 /* Some conditionally defined helper macros to keep process_tapping more
@@ -439,20 +471,76 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+/** \brief Waiting buffer key map
+ *
+ * The pressed or released map row of a key, NULL for keys off the matrix.
+ */
+static matrix_row_t *waiting_buffer_map(keypos_t key, bool pressed) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return NULL;
+    }
+    return pressed ? &waiting_buffer_pressed[key.row] : &waiting_buffer_released[key.row];
+}
+
+/** \brief Waiting buffer find
+ *
+ * The oldest queued event of a key pressed or released, NULL if there is none.
+ */
+static keyrecord_t *waiting_buffer_find(keypos_t key, bool pressed) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+        if (KEYEQ(key, waiting_buffer[i].event.key) && pressed == waiting_buffer[i].event.pressed) {
+            return &waiting_buffer[i];
+        }
+    }
+    return NULL;
+}
+
+/** \brief Waiting buffer has
+ *
+ * Whether a key pressed or released is queued.
+ */
+static bool waiting_buffer_has(keypos_t key, bool pressed) {
+    matrix_row_t *map = waiting_buffer_map(key, pressed);
+    if (map == NULL) {
+        return waiting_buffer_off_matrix > 0 && waiting_buffer_find(key, pressed) != NULL;
+    }
+    return *map & (MATRIX_ROW_SHIFTER << key.col);
+}
+
+/** \brief Waiting buffer full
+ */
+static bool waiting_buffer_full(void) {
+    return (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail;
+}
+
 /** \brief Waiting buffer enq
  *
- * FIXME: Needs docs
+ * Queues an event behind the undecided tapping key, false if the buffer is full.
  */
 bool waiting_buffer_enq(keyrecord_t record) {
     if (IS_NOEVENT(record.event)) {
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if (waiting_buffer_full()) {
         ac_dprintf("waiting_buffer_enq: Over flow.\n");
         return false;
     }
 
+    matrix_row_t *map = waiting_buffer_map(record.event.key, record.event.pressed);
+    if (map == NULL) {
+        waiting_buffer_off_matrix++;
+    } else {
+        matrix_row_t bit = MATRIX_ROW_SHIFTER << record.event.key.col;
+        if (*map & bit) {
+            waiting_buffer_repeats++;
+        }
+        *map |= bit;
+    }
+    if (record.event.pressed) {
+        waiting_buffer_presses++;
+    }
+
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
 
@@ -461,48 +549,84 @@ bool waiting_buffer_enq(keyrecord_t record) {
     return true;
 }
 
-/** \brief Waiting buffer clear
+/** \brief Waiting buffer deq
  *
- * FIXME: Needs docs
+ * Drops the oldest queued event, it has been processed.
  */
-void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+static void waiting_buffer_deq(void) {
+    keyevent_t event    = waiting_buffer[waiting_buffer_tail].event;
+    waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+
+    if (event.pressed) {
+        waiting_buffer_presses--;
+    }
+
+    matrix_row_t *map = waiting_buffer_map(event.key, event.pressed);
+    if (map == NULL) {
+        waiting_buffer_off_matrix--;
+    } else if (waiting_buffer_repeats > 0 && waiting_buffer_find(event.key, event.pressed) != NULL) {
+        // another copy is still queued, the key stays in the map
+        waiting_buffer_repeats--;
+    } else {
+        *map &= ~(MATRIX_ROW_SHIFTER << event.key.col);
+    }
 }
 
-/** \brief Waiting buffer typed
+/** \brief Waiting buffer make room
  *
- * FIXME: Needs docs
+ * Processes queued events until a slot is free, without losing any of them.
+ *
+ * Events only wait behind an undecided tapping key. By default it is decided as held,
+ * as if its tapping term had run out. With WAITING_BUFFER_FLUSH_OLDEST it stays undecided
+ * and the oldest queued event is processed ahead of it instead.
  */
-bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
-            return true;
+static void waiting_buffer_make_room(void) {
+    while (waiting_buffer_full()) {
+        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+            waiting_buffer_deq();
+        } else if (tapping_key.event.pressed && tapping_key.tap.count == 0) {
+#    ifdef WAITING_BUFFER_FLUSH_OLDEST
+            keyrecord_t oldest = waiting_buffer[waiting_buffer_tail];
+
+            ac_dprintf("OVERFLOW: FLUSH OLDEST\n");
+            waiting_buffer_deq();
+            process_record(&oldest);
+#    else
+            ac_dprintf("OVERFLOW: TAPPING KEY HELD\n");
+            process_record(&tapping_key);
+            tapping_key = (keyrecord_t){0};
+            debug_tapping_key();
+#    endif
         }
     }
-    return false;
+}
+
+/** \brief Waiting buffer typed
+ *
+ * Whether the opposite event of a key is queued, a press for a release and the other way around.
+ */
+bool waiting_buffer_typed(keyevent_t event) {
+    return waiting_buffer_has(event.key, !event.pressed);
 }
 
 /** \brief Waiting buffer has anykey pressed
  *
- * FIXME: Needs docs
+ * Whether any key press is queued.
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
-    }
-    return false;
+    return waiting_buffer_presses > 0;
 }
 
 /** \brief Scan buffer for tapping
  *
- * FIXME: Needs docs
+ * Settles the tapping key as a tap if its release is queued within the tapping term.
  */
 void waiting_buffer_scan_tap(void) {
     // early return if:
     // - tapping already is settled
     // - invalid state: tapping_key released && tap.count == 0
-    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed) {
+    // - the tapping key has no release queued
+    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed || !waiting_buffer_has(tapping_key.event.key, false)) {
         return;
     }
 
@@ -32,7 +32,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* events held back while a tapping key is undecided, one slot is kept free */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 8
+#endif
+#if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 128
+#    error "WAITING_BUFFER_SIZE must be between 2 and 128"
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action_layer.h"
 #include "timer.h"
 #include "keycode_config.h"
+#include "util.h"
 #include <string.h>
 
 extern keymap_config_t keymap_config;
@@ -36,9 +37,101 @@ static uint8_t suppressed_mods    = 0;
 // report_keyboard_t keyboard_report = {};
 report_keyboard_t *keyboard_report = &(report_keyboard_t){};
 
-extern inline void add_key(uint8_t key);
-extern inline void del_key(uint8_t key);
-extern inline void clear_keys(void);
+/* Shadow of the keys in keyboard_report while it is a 6KRO report: a bitmap of the usages
+ * in it and which slots of keys[] are taken, so adding and looking up a key never scans
+ * keys[]. It is read back from keys[] after clear_keys() or a switch from NKRO, the keys
+ * of keyboard_report must only change through the functions below.
+ */
+static uint8_t keys_shadow[32];
+static uint8_t keys_shadow_slots = 0;
+static bool    keys_shadow_valid = false;
+
+#define KEYS_SHADOW_FULL ((1 << KEYBOARD_REPORT_KEYS) - 1)
+
+static bool keys_shadow_has(uint8_t key) {
+    return keys_shadow[key >> 3] & (1 << (key & 7));
+}
+
+static bool keys_shadowed(void) {
+#ifdef RING_BUFFERED_6KRO_REPORT_ENABLE
+    // the ring buffer keeps its own order
+    return false;
+#else
+#    ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        keys_shadow_valid = false;
+        return false;
+    }
+#    endif
+    if (!keys_shadow_valid) {
+        memset(keys_shadow, 0, sizeof(keys_shadow));
+        keys_shadow_slots = 0;
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            uint8_t key = keyboard_report->keys[i];
+            if (key) {
+                keys_shadow[key >> 3] |= 1 << (key & 7);
+                keys_shadow_slots |= 1 << i;
+            }
+        }
+        keys_shadow_valid = true;
+    }
+    return true;
+#endif
+}
+
+/** \brief Adds a key to the keyboard report
+ *
+ * A 6KRO key takes the first free slot, a full report stays as it is.
+ */
+void add_key(uint8_t key) {
+    if (!keys_shadowed()) {
+        add_key_to_report(keyboard_report, key);
+        return;
+    }
+    if (!key || keys_shadow_has(key) || keys_shadow_slots == KEYS_SHADOW_FULL) {
+        return;
+    }
+    uint8_t slot                = biton(~keys_shadow_slots & (keys_shadow_slots + 1));
+    keyboard_report->keys[slot] = key;
+    keys_shadow_slots |= 1 << slot;
+    keys_shadow[key >> 3] |= 1 << (key & 7);
+}
+
+/** \brief Removes a key from the keyboard report
+ */
+void del_key(uint8_t key) {
+    if (!keys_shadowed()) {
+        del_key_from_report(keyboard_report, key);
+        return;
+    }
+    if (!key || !keys_shadow_has(key)) {
+        return;
+    }
+    keys_shadow[key >> 3] &= ~(1 << (key & 7));
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard_report->keys[i] == key) {
+            keyboard_report->keys[i] = 0;
+            keys_shadow_slots &= ~(1 << i);
+            break;
+        }
+    }
+}
+
+/** \brief Removes all keys, but not the modifiers, from the keyboard report
+ */
+void clear_keys(void) {
+    clear_keys_from_report(keyboard_report);
+    keys_shadow_valid = false;
+}
+
+/** \brief Checks whether a key is in the keyboard report
+ */
+bool has_key(uint8_t key) {
+    if (!keys_shadowed()) {
+        return is_key_pressed(keyboard_report, key);
+    }
+    return key && keys_shadow_has(key);
+}
 
 #ifndef NO_ACTION_ONESHOT
 static uint8_t oneshot_mods        = 0;
@@ -132,11 +225,13 @@ void set_oneshot_swaphands(void) {
         oneshot_layer_time = oneshot_swaphands_time;
     }
 #        endif
+    update_oneshot_deadline();
 }
 
 void release_oneshot_swaphands(void) {
     if (swap_hands_oneshot == SHO_PRESSED) {
         swap_hands_oneshot = SHO_ACTIVE;
+        update_oneshot_deadline();
     }
     if (swap_hands_oneshot == SHO_USED) {
         clear_oneshot_swaphands();
@@ -173,6 +268,7 @@ void set_oneshot_layer(uint8_t layer, uint8_t state) {
 #    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
         oneshot_layer_time = timer_read();
 #    endif
+        update_oneshot_deadline();
         oneshot_layer_changed_kb(get_oneshot_layer());
     } else {
         layer_on(layer);
@@ -250,6 +346,41 @@ bool is_oneshot_enabled(void) {
     return keymap_config.oneshot_enable;
 }
 
+/** \brief Update oneshot deadline
+ *
+ * Asks for tick events from the earliest oneshot timeout on, so action_exec() can clear it.
+ */
+void update_oneshot_deadline(void) {
+#    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+    uint16_t now     = timer_read();
+    uint16_t elapsed = 0;
+    bool     pending = false;
+
+    if (oneshot_mods) {
+        elapsed = TIMER_DIFF_16(now, oneshot_time);
+        pending = true;
+    }
+    if (get_oneshot_layer_state() && !(get_oneshot_layer_state() & ONESHOT_TOGGLED)) {
+        uint16_t layer_elapsed = TIMER_DIFF_16(now, oneshot_layer_time);
+        elapsed                = pending && elapsed > layer_elapsed ? elapsed : layer_elapsed;
+        pending                = true;
+    }
+#        ifdef SWAP_HANDS_ENABLE
+    if (swap_hands_oneshot == SHO_ACTIVE) {
+        uint16_t swaphands_elapsed = TIMER_DIFF_16(now, oneshot_swaphands_time);
+        elapsed                    = pending && elapsed > swaphands_elapsed ? elapsed : swaphands_elapsed;
+        pending                    = true;
+    }
+#        endif
+
+    if (pending) {
+        action_deadline_set(ACTION_DEADLINE_ONESHOT, now - elapsed + ONESHOT_TIMEOUT);
+    } else {
+        action_deadline_clear(ACTION_DEADLINE_ONESHOT);
+    }
+#    endif
+}
+
 #endif
 
 /** \brief Send keyboard report
@@ -269,7 +400,7 @@ void send_keyboard_report(void) {
         }
 #    endif
         keyboard_report->mods |= oneshot_mods;
-        if (has_anykey(keyboard_report)) {
+        if (keys_shadowed() ? keys_shadow_slots != 0 : has_anykey(keyboard_report)) {
             clear_oneshot_mods();
         }
     }
@@ -406,6 +537,7 @@ void add_oneshot_mods(uint8_t mods) {
         oneshot_time = timer_read();
 #    endif
         oneshot_mods |= mods;
+        update_oneshot_deadline();
         oneshot_mods_changed_kb(mods);
     }
 }
@@ -416,6 +548,7 @@ void del_oneshot_mods(uint8_t mods) {
 #    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
         oneshot_time = oneshot_mods ? timer_read() : 0;
 #    endif
+        update_oneshot_deadline();
         oneshot_mods_changed_kb(oneshot_mods);
     }
 }
@@ -431,6 +564,7 @@ void set_oneshot_mods(uint8_t mods) {
             oneshot_time = timer_read();
 #    endif
             oneshot_mods = mods;
+            update_oneshot_deadline();
             oneshot_mods_changed_kb(mods);
         }
     }
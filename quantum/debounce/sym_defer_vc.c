@@ -0,0 +1,145 @@
+/*
+Copyright 2023 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-key algorithm using vertical counters, with the same timing as sym_defer_pk.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+
+Instead of a counter byte per key, every row keeps its counters as bit planes: plane n
+holds bit n of the counter of every key in the row. A whole row is counted, compared and
+reset with a few bitwise operations per plane, and no memory is allocated at runtime.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+
+// A counter starts at 1 when its key changes and the key is pushed when it reaches
+// DEBOUNCE + 1, enough planes to hold that value.
+#    define DEBOUNCE_DONE (DEBOUNCE + 1)
+#    if DEBOUNCE_DONE < 4
+#        define DEBOUNCE_PLANES 2
+#    elif DEBOUNCE_DONE < 8
+#        define DEBOUNCE_PLANES 3
+#    elif DEBOUNCE_DONE < 16
+#        define DEBOUNCE_PLANES 4
+#    elif DEBOUNCE_DONE < 32
+#        define DEBOUNCE_PLANES 5
+#    elif DEBOUNCE_DONE < 64
+#        define DEBOUNCE_PLANES 6
+#    elif DEBOUNCE_DONE < 128
+#        define DEBOUNCE_PLANES 7
+#    elif DEBOUNCE_DONE < 256
+#        define DEBOUNCE_PLANES 8
+#    else
+#        define DEBOUNCE_PLANES 9
+#    endif
+
+static matrix_row_t debounce_planes[MATRIX_ROWS][DEBOUNCE_PLANES];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    memset(debounce_planes, 0, sizeof(debounce_planes));
+    counters_need_update = false;
+}
+
+void debounce_free(void) {}
+
+// Advances the counters of one row by elapsed_time and pushes the keys that are done
+static matrix_row_t update_row(matrix_row_t planes[], matrix_row_t raw, matrix_row_t *cooked, uint8_t elapsed_time) {
+    matrix_row_t delta  = raw ^ *cooked;
+    matrix_row_t active = 0;
+
+    // keys back at their debounced state stop counting
+    for (uint8_t i = 0; i < DEBOUNCE_PLANES; i++) {
+        planes[i] &= delta;
+        active |= planes[i];
+    }
+
+    while (active && elapsed_time--) {
+        // add one to every active counter, rippling the carry up the planes
+        matrix_row_t carry = active;
+        for (uint8_t i = 0; i < DEBOUNCE_PLANES && carry; i++) {
+            matrix_row_t next = planes[i] & carry;
+            planes[i] ^= carry;
+            carry = next;
+        }
+
+        matrix_row_t done = active;
+        for (uint8_t i = 0; i < DEBOUNCE_PLANES; i++) {
+            done &= (DEBOUNCE_DONE & (1 << i)) ? planes[i] : ~planes[i];
+        }
+        if (done) {
+            *cooked ^= done;
+            delta &= ~done;
+            active &= ~done;
+            for (uint8_t i = 0; i < DEBOUNCE_PLANES; i++) {
+                planes[i] &= ~done;
+            }
+        }
+    }
+
+    // keys that just changed start counting
+    planes[0] |= delta & ~active;
+    return active | delta;
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool    cooked_changed = false;
+    uint8_t elapsed_time   = 0;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_fast = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        elapsed_time = elapsed_fast > DEBOUNCE ? DEBOUNCE : elapsed_fast;
+    } else if (changed) {
+        last_time = timer_read_fast();
+    }
+
+    if (elapsed_time == 0 && !changed) {
+        return false;
+    }
+
+    counters_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t cooked_prev = cooked[row];
+        if (update_row(debounce_planes[row], raw[row], &cooked[row], elapsed_time)) {
+            counters_need_update = true;
+        }
+        cooked_changed |= cooked[row] != cooked_prev;
+    }
+
+    return cooked_changed;
+}
+
+#else
+#    include "none.c"
+#endif
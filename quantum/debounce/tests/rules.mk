@@ -33,6 +33,11 @@ debounce_sym_defer_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pr.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_defer_pr_tests.cpp
 
+debounce_sym_defer_vc_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_vc_tests.cpp
+
 debounce_sym_eager_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_eager_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_eager_pk.c \
@@ -47,3 +52,21 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+# sym_defer_vc against sym_defer_pk on random scans, at the counter widths' edges
+DEBOUNCE_RANDOM_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_reference.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_vc_random_tests.cpp
+
+debounce_sym_defer_vc_random_1_DEFS := -DMATRIX_ROWS=4 -DMATRIX_COLS=10 -DDEBOUNCE=1
+debounce_sym_defer_vc_random_1_SRC := $(DEBOUNCE_RANDOM_SRC)
+
+debounce_sym_defer_vc_random_5_DEFS := -DMATRIX_ROWS=5 -DMATRIX_COLS=16 -DDEBOUNCE=5
+debounce_sym_defer_vc_random_5_SRC := $(DEBOUNCE_RANDOM_SRC)
+
+debounce_sym_defer_vc_random_7_DEFS := -DMATRIX_ROWS=4 -DMATRIX_COLS=10 -DDEBOUNCE=7
+debounce_sym_defer_vc_random_7_SRC := $(DEBOUNCE_RANDOM_SRC)
+
+debounce_sym_defer_vc_random_30_DEFS := -DMATRIX_ROWS=3 -DMATRIX_COLS=20 -DDEBOUNCE=30
+debounce_sym_defer_vc_random_30_SRC := $(DEBOUNCE_RANDOM_SRC)
@@ -0,0 +1,112 @@
+/* Copyright 2023 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <string.h>
+
+extern "C" {
+#include "quantum.h"
+#include "timer.h"
+#include "debounce.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+bool debounce_pk(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_pk_init(uint8_t num_rows);
+void debounce_pk_free(void);
+}
+
+/* sym_defer_vc must debounce exactly like sym_defer_pk, it only stores the counters differently */
+
+class DebounceRandomTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(7777);
+        debounce_init(MATRIX_ROWS);
+        debounce_pk_init(MATRIX_ROWS);
+        memset(raw_, 0, sizeof(raw_));
+        memset(cooked_vc_, 0, sizeof(cooked_vc_));
+        memset(cooked_pk_, 0, sizeof(cooked_pk_));
+    }
+
+    void TearDown() override {
+        debounce_free();
+        debounce_pk_free();
+    }
+
+    // flips each key with a chance of 1 in `odds`, returns whether anything changed
+    bool bounce(uint32_t odds) {
+        bool changed = false;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (rng_() % odds == 0) {
+                    raw_[row] ^= (matrix_row_t)1 << col;
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    void scan(bool changed, uint32_t i) {
+        bool vc_changed = debounce(raw_, cooked_vc_, MATRIX_ROWS, changed);
+        bool pk_changed = debounce_pk(raw_, cooked_pk_, MATRIX_ROWS, changed);
+        ASSERT_EQ(vc_changed, pk_changed) << "scan " << i;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            ASSERT_EQ(cooked_vc_[row], cooked_pk_[row]) << "scan " << i << ", row " << (int)row;
+        }
+    }
+
+    std::mt19937 rng_{DEBOUNCE};
+    matrix_row_t raw_[MATRIX_ROWS];
+    matrix_row_t cooked_vc_[MATRIX_ROWS];
+    matrix_row_t cooked_pk_[MATRIX_ROWS];
+};
+
+TEST_F(DebounceRandomTest, FastScans) {
+    // several scans per millisecond, keys bounce now and then
+    for (uint32_t i = 0; i < 200000; i++) {
+        if (rng_() % 4 == 0) {
+            advance_time(1);
+        }
+        ASSERT_NO_FATAL_FAILURE(scan(bounce(64), i));
+    }
+}
+
+TEST_F(DebounceRandomTest, SlowScansAndTimeJumps) {
+    // scans that take a few milliseconds, and some long stalls
+    for (uint32_t i = 0; i < 200000; i++) {
+        uint32_t r = rng_() % 100;
+        if (r < 2) {
+            advance_time(DEBOUNCE + rng_() % 300);
+        } else if (r < 50) {
+            advance_time(rng_() % 4);
+        }
+        ASSERT_NO_FATAL_FAILURE(scan(bounce(r < 10 ? 4 : 32), i));
+    }
+}
+
+TEST_F(DebounceRandomTest, ChangedFlagWithoutChange) {
+    // the matrix code may report a change that undid itself within the scan
+    for (uint32_t i = 0; i < 100000; i++) {
+        advance_time(rng_() % 3);
+        bool changed = bounce(48);
+        ASSERT_NO_FATAL_FAILURE(scan(changed || rng_() % 8 == 0, i));
+    }
+}
@@ -2,6 +2,11 @@ TEST_LIST += \
 	debounce_sym_defer_g \
 	debounce_sym_defer_pk \
 	debounce_sym_defer_pr \
+	debounce_sym_defer_vc \
+	debounce_sym_defer_vc_random_1 \
+	debounce_sym_defer_vc_random_5 \
+	debounce_sym_defer_vc_random_7 \
+	debounce_sym_defer_vc_random_30 \
 	debounce_sym_eager_pk \
 	debounce_sym_eager_pr \
 	debounce_asym_eager_defer_pk
@@ -98,6 +98,33 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+// Optional RAM copy of the lowest (usually hottest) layers, so keycode lookups
+// don't go to EEPROM. It holds the bytes exactly as stored in EEPROM, every
+// write through this file updates it too.
+#ifdef DYNAMIC_KEYMAP_CACHE_LAYERS
+#    if DYNAMIC_KEYMAP_CACHE_LAYERS > DYNAMIC_KEYMAP_LAYER_COUNT
+#        undef DYNAMIC_KEYMAP_CACHE_LAYERS
+#        define DYNAMIC_KEYMAP_CACHE_LAYERS DYNAMIC_KEYMAP_LAYER_COUNT
+#    endif
+#    define DYNAMIC_KEYMAP_CACHE_SIZE (DYNAMIC_KEYMAP_CACHE_LAYERS * MATRIX_ROWS * MATRIX_COLS * 2)
+
+static uint8_t dynamic_keymap_cache[DYNAMIC_KEYMAP_CACHE_SIZE];
+static bool    dynamic_keymap_cache_valid = false;
+
+static void dynamic_keymap_cache_update(uint16_t offset, uint8_t value) {
+    if (dynamic_keymap_cache_valid && offset < DYNAMIC_KEYMAP_CACHE_SIZE) {
+        dynamic_keymap_cache[offset] = value;
+    }
+}
+#endif
+
+void dynamic_keymap_cache_invalidate(void) {
+#ifdef DYNAMIC_KEYMAP_CACHE_LAYERS
+    dynamic_keymap_cache_valid = false;
+#endif
+    resolved_layer_table_invalidate();
+}
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -109,6 +136,16 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_CACHE_LAYERS
+    if (layer < DYNAMIC_KEYMAP_CACHE_LAYERS) {
+        if (!dynamic_keymap_cache_valid) {
+            eeprom_read_block(dynamic_keymap_cache, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_CACHE_SIZE);
+            dynamic_keymap_cache_valid = true;
+        }
+        uint8_t *cached = &dynamic_keymap_cache[(layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2)];
+        return (cached[0] << 8) | cached[1];
+    }
+#endif
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
@@ -122,6 +159,12 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#ifdef DYNAMIC_KEYMAP_CACHE_LAYERS
+    uint16_t offset = (uintptr_t)address - DYNAMIC_KEYMAP_EEPROM_ADDR;
+    dynamic_keymap_cache_update(offset, (uint8_t)(keycode >> 8));
+    dynamic_keymap_cache_update(offset + 1, (uint8_t)(keycode & 0xFF));
+#endif
+    resolved_layer_table_invalidate();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -175,7 +218,7 @@ void dynamic_keymap_reset(void) {
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
@@ -190,15 +233,19 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
             eeprom_update_byte(target, *source);
+#ifdef DYNAMIC_KEYMAP_CACHE_LAYERS
+            dynamic_keymap_cache_update(offset + i, *source);
+#endif
         }
         source++;
         target++;
     }
+    resolved_layer_table_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -226,7 +273,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -240,7 +287,7 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -27,6 +27,9 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
 #endif // ENCODER_MAP_ENABLE
 void dynamic_keymap_reset(void);
+// Drops the RAM copy of the keymap kept with DYNAMIC_KEYMAP_CACHE_LAYERS, call it after
+// writing keymap EEPROM other than through the functions here. No-op without the cache.
+void dynamic_keymap_cache_invalidate(void);
 // These get/set the keycodes as stored in the EEPROM buffer
 // Data is big-endian 16-bit values (the keycodes)
 // Order is by layer/row/column
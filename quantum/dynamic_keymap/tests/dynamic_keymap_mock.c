@@ -0,0 +1,48 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "dynamic_keymap_mock.h"
+#include "eeprom.h"
+#include "keycodes.h"
+
+uint32_t       mock_eeprom_reads = 0;
+static uint8_t mock_eeprom[TOTAL_EEPROM_BYTE_COUNT];
+
+void mock_eeprom_reset(void) {
+    memset(mock_eeprom, 0xFF, sizeof(mock_eeprom));
+    mock_eeprom_reads = 0;
+}
+
+uint8_t eeprom_read_byte(const uint8_t *addr) {
+    mock_eeprom_reads++;
+    return mock_eeprom[(uintptr_t)addr];
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    const uint8_t *p    = (const uint8_t *)addr;
+    uint8_t *      dest = (uint8_t *)buf;
+    while (len--) {
+        *dest++ = eeprom_read_byte(p++);
+    }
+}
+
+void eeprom_update_byte(uint8_t *addr, uint8_t value) {
+    mock_eeprom[(uintptr_t)addr] = value;
+}
+
+// Layer 0: KC_A + column on every key, layer 1: KC_1 + column on row 0, transparent elsewhere
+uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (layer_num == 0) return KC_A + column;
+    if (layer_num == 1 && row == 0) return KC_1 + column;
+    return KC_TRANSPARENT;
+}
+
+uint8_t keymap_layer_count(void) {
+    return 2;
+}
+
+// dynamic macros are not under test
+void send_string_with_delay(const char *string, uint8_t interval) {}
+void send_string_with_delay_P(const char *string, uint8_t interval) {}
+void wait_ms(uint32_t ms) {}
@@ -0,0 +1,11 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+// EEPROM reads since the last reset
+extern uint32_t mock_eeprom_reads;
+
+void mock_eeprom_reset(void);
@@ -0,0 +1,101 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "dynamic_keymap_mock.h"
+#include "keycodes.h"
+}
+
+class DynamicKeymap : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_eeprom_reset();
+        dynamic_keymap_cache_invalidate();
+        dynamic_keymap_reset();
+        mock_eeprom_reads = 0;
+    }
+
+    // The lookups a key press costs: layer_switch_get_layer() reads the active layers
+    // from the top until a key is not transparent, then the action is built from that
+    // layer's keycode.
+    uint16_t press(uint8_t highest_layer, uint8_t row, uint8_t column) {
+        uint8_t layer = 0;
+        for (int8_t i = highest_layer; i >= 0; i--) {
+            if (dynamic_keymap_get_keycode(i, row, column) != KC_TRANSPARENT) {
+                layer = i;
+                break;
+            }
+        }
+        return dynamic_keymap_get_keycode(layer, row, column);
+    }
+
+    // EEPROM reads per keystroke, averaged over every key after a warm-up press
+    double reads_per_keystroke(uint8_t highest_layer) {
+        press(highest_layer, 0, 0);
+        mock_eeprom_reads = 0;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                press(highest_layer, row, column);
+            }
+        }
+        return (double)mock_eeprom_reads / (MATRIX_ROWS * MATRIX_COLS);
+    }
+};
+
+TEST_F(DynamicKeymap, ReadsPerKeystroke) {
+    double base    = reads_per_keystroke(0);
+    double layered = reads_per_keystroke(1);
+    RecordProperty("eeprom_reads_per_keystroke_base_layer", std::to_string(base));
+    RecordProperty("eeprom_reads_per_keystroke_layer_1", std::to_string(layered));
+    printf("EEPROM reads per keystroke: %.2f on layer 0, %.2f with layer 1 on top\n", base, layered);
+
+#ifdef DYNAMIC_KEYMAP_CACHE_LAYERS
+    EXPECT_EQ(base, 0);
+    EXPECT_EQ(layered, 0);
+#else
+    // two byte reads per lookup, one lookup per layer tried plus the final one
+    EXPECT_EQ(base, 4);
+    EXPECT_GT(layered, 4);
+#endif
+}
+
+TEST_F(DynamicKeymap, LookupMatchesKeymap) {
+    EXPECT_EQ(press(0, 2, 3), KC_A + 3);
+    EXPECT_EQ(press(1, 0, 3), KC_1 + 3);
+    EXPECT_EQ(press(1, 2, 3), KC_A + 3);
+    EXPECT_EQ(dynamic_keymap_get_keycode(3, 0, 0), KC_TRANSPARENT);
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0), KC_NO);
+}
+
+TEST_F(DynamicKeymap, SetKeycodeIsVisible) {
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_A + 1);
+    dynamic_keymap_set_keycode(0, 1, 1, KC_LEFT_CTRL);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_LEFT_CTRL);
+    dynamic_keymap_set_keycode(3, 1, 1, KC_ESCAPE);
+    EXPECT_EQ(dynamic_keymap_get_keycode(3, 1, 1), KC_ESCAPE);
+}
+
+TEST_F(DynamicKeymap, SetBufferIsVisible) {
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_1);
+
+    // layer 1, row 0, column 0 and 1, big endian
+    uint8_t  data[]   = {0x00, KC_ENTER, 0x00, KC_SPACE};
+    uint16_t offset   = 1 * MATRIX_ROWS * MATRIX_COLS * 2;
+    dynamic_keymap_set_buffer(offset, sizeof(data), data);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_ENTER);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 1), KC_SPACE);
+
+    uint8_t readback[4];
+    dynamic_keymap_get_buffer(offset, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(readback, data, sizeof(data)), 0);
+}
+
+TEST_F(DynamicKeymap, ResetRestoresKeymap) {
+    dynamic_keymap_get_keycode(0, 0, 0);
+    dynamic_keymap_set_keycode(0, 0, 0, KC_NO);
+    dynamic_keymap_reset();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+}
@@ -0,0 +1,21 @@
+# The same tests run with and without the RAM keymap cache, dynamic_keymap_tests.cpp
+# compares the EEPROM reads per keystroke of both.
+
+dynamic_keymap_DEFS := \
+	-DMATRIX_ROWS=5 \
+	-DMATRIX_COLS=16 \
+	-DDYNAMIC_KEYMAP_LAYER_COUNT=4 \
+	-DEEPROM_CUSTOM \
+	-DEEPROM_SIZE=1024 \
+	-DDYNAMIC_KEYMAP_EEPROM_ADDR=32 \
+	-DSEND_STRING_ENABLE \
+	-DNO_PRINT \
+	-DNO_DEBUG
+
+dynamic_keymap_SRC := \
+	$(QUANTUM_PATH)/dynamic_keymap/tests/dynamic_keymap_mock.c \
+	$(QUANTUM_PATH)/dynamic_keymap/tests/dynamic_keymap_tests.cpp \
+	$(QUANTUM_PATH)/dynamic_keymap.c
+
+dynamic_keymap_cache_DEFS := $(dynamic_keymap_DEFS) -DDYNAMIC_KEYMAP_CACHE_LAYERS=2
+dynamic_keymap_cache_SRC := $(dynamic_keymap_SRC)
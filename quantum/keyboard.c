@@ -26,6 +26,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "keycode.h"
 #include "timer.h"
 #include "sync_timer.h"
+#include "task_profiler.h"
 #include "print.h"
 #include "debug.h"
 #include "command.h"
@@ -108,6 +109,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef LEADER_ENABLE
 #    include "leader.h"
 #endif
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_master.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -278,6 +282,22 @@ __attribute__((weak)) bool matrix_can_read(void) {
     return true;
 }
 
+#ifdef KEYBOARD_IDLE_TIMEOUT
+/* Parking the matrix, see matrix.h. The built-in matrix defines these weak so a
+ * keyboard can replace them, a custom matrix may define them too. Without
+ * matrix_park() idle mode keeps scanning.
+ */
+__attribute__((weak)) bool matrix_park(void);
+__attribute__((weak)) bool matrix_parked_pressed(void);
+__attribute__((weak)) void matrix_unpark(void);
+
+/** \brief keyboard_idle_sleep
+ *
+ * Waits for the next interrupt while the keyboard is idle, overridden by platforms that can sleep.
+ */
+__attribute__((weak)) void keyboard_idle_sleep(void) {}
+#endif
+
 /** \brief keyboard_setup
  *
  * FIXME: needs doc
@@ -339,6 +359,10 @@ __attribute__((weak)) void housekeeping_task_user(void) {}
  * Invokes hooks for executing code after QMK is done after each loop iteration.
  */
 void housekeeping_task(void) {
+#ifdef I2C_ASYNC_ENABLE
+    // completion callbacks of the interrupt driven I2C transfers
+    i2c_async_task();
+#endif
     housekeeping_task_kb();
     housekeeping_task_user();
 }
@@ -454,14 +478,31 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 #endif
 }
 
+static uint32_t tick_events_skipped = 0;
+
+/**
+ * @brief Number of tick events that were not generated because no deadline had expired.
+ */
+uint32_t get_tick_events_skipped(void) {
+    return tick_events_skipped;
+}
+
 /**
  * @brief Generates a tick event at a maximum rate of 1KHz that drives the
- * internal QMK state machine.
+ * internal QMK state machine. Unless TICK_EVENT_EVERY_MS is defined, only once
+ * one of the action deadlines has expired, there is nothing for a tick to do before.
  */
 static inline void generate_tick_event(void) {
     static uint16_t last_tick = 0;
     const uint16_t  now       = timer_read();
     if (TIMER_DIFF_16(now, last_tick) != 0) {
+#ifndef TICK_EVENT_EVERY_MS
+        if (!action_deadline_expired(now)) {
+            tick_events_skipped++;
+            last_tick = now;
+            return;
+        }
+#endif
         action_exec(MAKE_TICK_EVENT);
         last_tick = now;
     }
@@ -489,6 +530,7 @@ static bool matrix_task(void) {
     }
 
     matrix_scan_perf_task();
+    task_profiler_matrix_scanned(matrix_changed);
 
     // Short-circuit the complete matrix processing if it is not necessary
     if (!matrix_changed) {
@@ -529,6 +571,78 @@ static bool matrix_task(void) {
     return matrix_changed;
 }
 
+#ifdef KEYBOARD_IDLE_TIMEOUT
+#    ifndef KEYBOARD_IDLE_WAKE_WINDOW
+#        define KEYBOARD_IDLE_WAKE_WINDOW 100
+#    endif
+
+static bool idle_mode        = false;
+static bool idle_mode_parked = false;
+static bool idle_mode_woken  = false;
+static bool idle_mode_held   = false;
+
+/**
+ * @brief Parks the matrix once there has been no input for KEYBOARD_IDLE_TIMEOUT
+ * milliseconds and no key is held, and wakes it again on the first key down or on
+ * any other input.
+ *
+ * @return true The matrix is parked with no key down, scanning can be skipped
+ * @return false The matrix has to be scanned
+ */
+static bool keyboard_idle_task(void) {
+    if (!idle_mode) {
+        // a pending deadline still needs its tick events, queued taps their reports
+        if (idle_mode_held || action_deadline_pending() || host_extra_tap_pending() || last_input_activity_elapsed() < KEYBOARD_IDLE_TIMEOUT) {
+            return false;
+        }
+        idle_mode        = true;
+        idle_mode_parked = matrix_park && matrix_parked_pressed && matrix_park();
+        idle_mode_woken  = false;
+    }
+
+    bool wake = last_input_activity_elapsed() < KEYBOARD_IDLE_TIMEOUT;
+    if (idle_mode_parked && matrix_parked_pressed()) {
+        // stamp the edge, the report it leads to is measured from here
+        last_matrix_activity_trigger();
+        idle_mode_woken = true;
+        wake            = true;
+    }
+
+    if (wake) {
+        if (idle_mode_parked && matrix_unpark) {
+            matrix_unpark();
+        }
+        idle_mode        = false;
+        idle_mode_parked = false;
+        return false;
+    }
+    return idle_mode_parked;
+}
+
+/**
+ * @brief Records matrix activity and whether a key is still down. The first change
+ * after a wake keeps the time of the wake, so last_matrix_activity_elapsed() reads
+ * the wake to report latency.
+ */
+static void keyboard_idle_matrix_changed(void) {
+    idle_mode_held = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            idle_mode_held = true;
+            break;
+        }
+    }
+
+    if (idle_mode_woken && last_matrix_activity_elapsed() <= KEYBOARD_IDLE_WAKE_WINDOW) {
+        idle_mode_woken = false;
+        dprintf("idle wake to report: %lums\n", last_matrix_activity_elapsed());
+        return;
+    }
+    idle_mode_woken = false;
+    last_matrix_activity_trigger();
+}
+#endif
+
 /** \brief Tasks previously located in matrix_scan_quantum
  *
  * TODO: rationalise against keyboard_task and current split role
@@ -611,50 +725,73 @@ void quantum_task(void) {
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+#ifdef TASK_PROFILER_ENABLE
+    uint32_t keyboard_task_start = task_profiler_timestamp();
+#endif
+    bool matrix_changed = false;
+#ifdef KEYBOARD_IDLE_TIMEOUT
+    // while parked there is no scan and no tick event, until a key goes down
+    bool matrix_parked = false;
+    TASK_PROFILE(TASK_PROFILER_MATRIX, matrix_parked = keyboard_idle_task(); matrix_changed = !matrix_parked && matrix_task());
+    if (matrix_parked) {
+        // the scan hooks keep running once per pass, e.g. for time based keymap code
+        matrix_scan_kb();
+    }
+    if (matrix_changed) {
+        keyboard_idle_matrix_changed();
+        activity_has_occurred = true;
+    }
+#else
+    TASK_PROFILE(TASK_PROFILER_MATRIX, matrix_changed = matrix_task());
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
+#endif
 
-    quantum_task();
+    TASK_PROFILE(TASK_PROFILER_QUANTUM, quantum_task());
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    TASK_PROFILE(TASK_PROFILER_RGBLIGHT, rgblight_task());
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    TASK_PROFILE(TASK_PROFILER_LED_MATRIX, led_matrix_task());
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    TASK_PROFILE(TASK_PROFILER_RGB_MATRIX, rgb_matrix_task());
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
+    TASK_PROFILE(TASK_PROFILER_BACKLIGHT, backlight_task());
 #    endif
 #endif
 
 #ifdef ENCODER_ENABLE
-    if (encoder_read()) {
+    bool encoder_changed;
+    TASK_PROFILE(TASK_PROFILER_ENCODER, encoder_changed = encoder_read());
+    if (encoder_changed) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    bool pointing_device_changed;
+    TASK_PROFILE(TASK_PROFILER_POINTING_DEVICE, pointing_device_changed = pointing_device_task());
+    if (pointing_device_changed) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef OLED_ENABLE
-    oled_task();
+    TASK_PROFILE(TASK_PROFILER_OLED, oled_task());
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -662,7 +799,7 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
-    st7565_task();
+    TASK_PROFILE(TASK_PROFILER_ST7565, st7565_task());
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
@@ -671,7 +808,7 @@ void keyboard_task(void) {
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
-    mousekey_task();
+    TASK_PROFILE(TASK_PROFILER_MOUSEKEY, mousekey_task());
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
@@ -696,5 +833,19 @@ void keyboard_task(void) {
     bluetooth_task();
 #endif
 
-    led_task();
+#if defined(EXTRAKEY_ENABLE) && defined(EXTRA_TAP_QUEUE_ENABLE)
+    host_extra_task();
+#endif
+
+    TASK_PROFILE(TASK_PROFILER_LED, led_task());
+
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_record(TASK_PROFILER_KEYBOARD, keyboard_task_start);
+#endif
+
+#ifdef KEYBOARD_IDLE_TIMEOUT
+    if (idle_mode) {
+        keyboard_idle_sleep();
+    }
+#endif
 }
@@ -125,6 +125,9 @@ uint32_t last_pointing_device_activity_elapsed(void); // Number of milliseconds
 void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timestamp, uint32_t pointing_device_timestamp); // Set the timestamps of the last matrix and encoder activity
 
 uint32_t get_matrix_scan_rate(void);
+uint32_t get_tick_events_skipped(void); // Tick events not generated since startup, see TICK_EVENT_EVERY_MS
+
+void keyboard_idle_sleep(void); // Waits for the next interrupt while the keyboard is idle, see KEYBOARD_IDLE_TIMEOUT
 
 #ifdef __cplusplus
 }
@@ -15,6 +15,7 @@
  */
 
 #include "keyboard.h"
+#include "task_profiler.h"
 
 void platform_setup(void);
 
@@ -57,20 +58,30 @@ int main(void) {
 
     /* Main loop */
     while (true) {
+#ifdef TASK_PROFILER_ENABLE
+        uint32_t loop_start = task_profiler_timestamp();
+#endif
+
         protocol_task();
 
 #ifdef QUANTUM_PAINTER_ENABLE
         // Run Quantum Painter task
         void qp_internal_task(void);
-        qp_internal_task();
+        TASK_PROFILE(TASK_PROFILER_QUANTUM_PAINTER, qp_internal_task());
 #endif
 
 #ifdef DEFERRED_EXEC_ENABLE
         // Run deferred executions
         void deferred_exec_task(void);
-        deferred_exec_task();
+        TASK_PROFILE(TASK_PROFILER_DEFERRED_EXEC, deferred_exec_task());
 #endif // DEFERRED_EXEC_ENABLE
 
-        housekeeping_task();
+        TASK_PROFILE(TASK_PROFILER_HOUSEKEEPING, housekeeping_task());
+
+#ifdef TASK_PROFILER_ENABLE
+        task_profiler_record(TASK_PROFILER_LOOP, loop_start);
+        // outside of the loop sample, printing is not part of the budget
+        task_profiler_task();
+#endif
     }
 }
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "quantum.h"
+#include "task_profiler.h"
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -132,6 +133,25 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#    if defined(KEYBOARD_IDLE_TIMEOUT) && !defined(SPLIT_KEYBOARD)
+__attribute__((weak)) bool matrix_park(void) {
+    return true;
+}
+
+__attribute__((weak)) bool matrix_parked_pressed(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (!readMatrixPin(direct_pins[row][col])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+__attribute__((weak)) void matrix_unpark(void) {}
+#    endif
+
 #elif defined(DIODE_DIRECTION)
 #    if defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
 #        if (DIODE_DIRECTION == COL2ROW)
@@ -162,6 +182,70 @@ static void unselect_rows(void) {
     }
 }
 
+#            if defined(MATRIX_COL_PORT_READ) && defined(PINx_ADDRESS)
+// Columns grouped by port: each PINx register is read once per row, and all the
+// columns that sit the same distance away from their port bit are moved into
+// place with a single mask and shift. Runs of the same port are kept together.
+// Needs the PINx registers, so AVR only (and the mocked ports of the unit tests).
+typedef struct {
+    volatile uint8_t *pin_reg;
+    uint8_t           mask;
+    int8_t            shift;
+} col_port_run_t;
+
+static col_port_run_t col_port_runs[MATRIX_COLS];
+static uint8_t        col_port_run_count;
+
+static void init_col_port_runs(void) {
+    col_port_run_count = 0;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pin_t pin = col_pins[col];
+        if (pin == NO_PIN) {
+            continue;
+        }
+
+        volatile uint8_t *pin_reg = &PINx_ADDRESS(pin);
+        int8_t            shift   = col - (pin & 0xF);
+        uint8_t           i       = 0;
+
+        // skip to the runs of this port, then to the one with the same shift
+        while (i < col_port_run_count && col_port_runs[i].pin_reg != pin_reg) {
+            i++;
+        }
+        while (i < col_port_run_count && col_port_runs[i].pin_reg == pin_reg && col_port_runs[i].shift != shift) {
+            i++;
+        }
+        if (i == col_port_run_count || col_port_runs[i].pin_reg != pin_reg) {
+            memmove(&col_port_runs[i + 1], &col_port_runs[i], (col_port_run_count - i) * sizeof(col_port_run_t));
+            col_port_runs[i] = (col_port_run_t){.pin_reg = pin_reg, .mask = 0, .shift = shift};
+            col_port_run_count++;
+        }
+        col_port_runs[i].mask |= _BV(pin & 0xF);
+    }
+}
+
+static matrix_row_t read_col_ports(void) {
+    matrix_row_t      row_value = 0;
+    volatile uint8_t *pin_reg   = NULL;
+    uint8_t           pressed   = 0;
+
+    for (uint8_t i = 0; i < col_port_run_count; i++) {
+        const col_port_run_t *run = &col_port_runs[i];
+        if (run->pin_reg != pin_reg) {
+            pin_reg = run->pin_reg;
+#                if MATRIX_INPUT_PRESSED_STATE == 0
+            pressed = ~*pin_reg;
+#                else
+            pressed = *pin_reg;
+#                endif
+        }
+        matrix_row_t bits = pressed & run->mask;
+        row_value |= run->shift >= 0 ? bits << run->shift : bits >> -run->shift;
+    }
+    return row_value;
+}
+#            endif
+
 __attribute__((weak)) void matrix_init_pins(void) {
     unselect_rows();
     for (uint8_t x = 0; x < MATRIX_COLS; x++) {
@@ -180,6 +264,9 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            if defined(MATRIX_COL_PORT_READ) && defined(PINx_ADDRESS)
+    current_row_value = read_col_ports();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -188,6 +275,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -197,6 +285,33 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#            if defined(KEYBOARD_IDLE_TIMEOUT) && !defined(SPLIT_KEYBOARD)
+__attribute__((weak)) bool matrix_park(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+    matrix_output_select_delay();
+    return true;
+}
+
+__attribute__((weak)) bool matrix_parked_pressed(void) {
+#                if defined(MATRIX_COL_PORT_READ) && defined(PINx_ADDRESS)
+    return read_col_ports() != 0;
+#                else
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (!readMatrixPin(col_pins[col])) {
+            return true;
+        }
+    }
+    return false;
+#                endif
+}
+
+__attribute__((weak)) void matrix_unpark(void) {
+    unselect_rows();
+}
+#            endif
+
 #        elif (DIODE_DIRECTION == ROW2COL)
 
 static bool select_col(uint8_t col) {
@@ -261,6 +376,29 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     matrix_output_unselect_delay(current_col, key_pressed); // wait for all Row signals to go HIGH
 }
 
+#            if defined(KEYBOARD_IDLE_TIMEOUT) && !defined(SPLIT_KEYBOARD)
+__attribute__((weak)) bool matrix_park(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+    matrix_output_select_delay();
+    return true;
+}
+
+__attribute__((weak)) bool matrix_parked_pressed(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (!readMatrixPin(row_pins[row])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+__attribute__((weak)) void matrix_unpark(void) {
+    unselect_cols();
+}
+#            endif
+
 #        else
 #            error DIODE_DIRECTION must be one of COL2ROW or ROW2COL!
 #        endif
@@ -299,6 +437,10 @@ void matrix_init(void) {
     thatHand = ROWS_PER_HAND - thisHand;
 #endif
 
+#if defined(MATRIX_COL_PORT_READ) && defined(PINx_ADDRESS) && !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW) && defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+    init_col_port_runs();
+#endif
+
     // initialize key pins
     matrix_init_pins();
 
@@ -336,7 +478,10 @@ uint8_t matrix_scan(void) {
 #endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
-    if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
+    if (changed) {
+        memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
+        task_profiler_raw_changed();
+    }
 
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
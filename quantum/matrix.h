@@ -69,6 +69,12 @@ void matrix_io_delay(void);
 void matrix_power_up(void);
 void matrix_power_down(void);
 
+/* idle mode, every line selected at once so any key down shows up in one read.
+ * The built-in matrix defines these weak, a custom matrix may define them. */
+bool matrix_park(void);
+bool matrix_parked_pressed(void);
+void matrix_unpark(void);
+
 void matrix_init_kb(void);
 void matrix_scan_kb(void);
 
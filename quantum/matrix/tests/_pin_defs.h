@@ -0,0 +1,65 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+/* AVR style pin numbers, port in the high nibble and bit in the low one. Each
+ * port has a PINx register the matrix reads, see mock_gpio.c.
+ */
+#define MOCK_PORT_COUNT 6
+
+extern volatile uint8_t mock_pin_regs[MOCK_PORT_COUNT];
+
+#define PINDEF(port, bit) ((((port) - 'A') << 4) | (bit))
+#define PINx_ADDRESS(pin) (mock_pin_regs[(pin) >> 4])
+#define _BV(bit) (1 << (bit))
+
+#define A0 PINDEF('A', 0)
+#define A1 PINDEF('A', 1)
+#define A2 PINDEF('A', 2)
+#define A3 PINDEF('A', 3)
+#define A4 PINDEF('A', 4)
+#define A5 PINDEF('A', 5)
+#define A6 PINDEF('A', 6)
+#define A7 PINDEF('A', 7)
+#define B0 PINDEF('B', 0)
+#define B1 PINDEF('B', 1)
+#define B2 PINDEF('B', 2)
+#define B3 PINDEF('B', 3)
+#define B4 PINDEF('B', 4)
+#define B5 PINDEF('B', 5)
+#define B6 PINDEF('B', 6)
+#define B7 PINDEF('B', 7)
+#define C0 PINDEF('C', 0)
+#define C1 PINDEF('C', 1)
+#define C2 PINDEF('C', 2)
+#define C3 PINDEF('C', 3)
+#define C4 PINDEF('C', 4)
+#define C5 PINDEF('C', 5)
+#define C6 PINDEF('C', 6)
+#define C7 PINDEF('C', 7)
+#define D0 PINDEF('D', 0)
+#define D1 PINDEF('D', 1)
+#define D2 PINDEF('D', 2)
+#define D3 PINDEF('D', 3)
+#define D4 PINDEF('D', 4)
+#define D5 PINDEF('D', 5)
+#define D6 PINDEF('D', 6)
+#define D7 PINDEF('D', 7)
+#define E0 PINDEF('E', 0)
+#define E1 PINDEF('E', 1)
+#define E2 PINDEF('E', 2)
+#define E3 PINDEF('E', 3)
+#define E4 PINDEF('E', 4)
+#define E5 PINDEF('E', 5)
+#define E6 PINDEF('E', 6)
+#define E7 PINDEF('E', 7)
+#define F0 PINDEF('F', 0)
+#define F1 PINDEF('F', 1)
+#define F2 PINDEF('F', 2)
+#define F3 PINDEF('F', 3)
+#define F4 PINDEF('F', 4)
+#define F5 PINDEF('F', 5)
+#define F6 PINDEF('F', 6)
+#define F7 PINDEF('F', 7)
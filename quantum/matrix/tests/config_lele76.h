@@ -0,0 +1,12 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// keyboards/lelelab/lele76, 16 columns on ports B, A, C and D
+#define MATRIX_ROWS 5
+#define MATRIX_COLS 16
+#define MATRIX_ROW_PINS \
+    { A0, A1, A2, A3, A4 }
+#define MATRIX_COL_PINS \
+    { B0, B1, B2, B3, B4, A5, A6, A7, C7, C6, C5, C4, C3, C2, D7, D4 }
+#define DIODE_DIRECTION COL2ROW
@@ -0,0 +1,13 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// runs with positive and negative shifts, a port coming back after another
+// one, a missing column and a 32 bit row
+#define MATRIX_ROWS 3
+#define MATRIX_COLS 20
+#define MATRIX_ROW_PINS \
+    { E1, E2, F0 }
+#define MATRIX_COL_PINS \
+    { D7, D6, NO_PIN, C0, C1, C2, D5, B7, B0, B1, A3, A2, A1, A0, C3, C7, E0, D0, F7, F6 }
+#define DIODE_DIRECTION COL2ROW
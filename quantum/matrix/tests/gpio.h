@@ -0,0 +1,20 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include "pin_defs.h"
+
+typedef uint8_t pin_t;
+
+/* A switch matrix behind mocked ports: a column pin reads low while a pressed
+ * key connects it to a row that is driven low.
+ */
+void mock_gpio_set_output(pin_t pin, bool output);
+void mock_gpio_write(pin_t pin, bool high);
+
+#define setPinInputHigh(pin) mock_gpio_set_output(pin, false)
+#define setPinOutput(pin) mock_gpio_set_output(pin, true)
+#define writePinLow(pin) mock_gpio_write(pin, false)
+#define writePinHigh(pin) mock_gpio_write(pin, true)
+#define readPin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin)&0xF)))
@@ -0,0 +1,88 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <random>
+
+extern "C" {
+#include "matrix.h"
+#include "mock_gpio.h"
+}
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+class MatrixTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_gpio_reset();
+        matrix_init();
+    }
+
+    // presses the keys set in `rows` and returns what a pin by pin read sees
+    void press(const matrix_row_t rows[MATRIX_ROWS], matrix_row_t expected[MATRIX_ROWS]) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            expected[row] = 0;
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                bool pressed = rows[row] & ((matrix_row_t)1 << col);
+                if (col_pins[col] == NO_PIN) {
+                    continue;
+                }
+                mock_gpio_press(row_pins[row], col_pins[col], pressed);
+                if (pressed) {
+                    expected[row] |= (matrix_row_t)1 << col;
+                }
+            }
+        }
+    }
+
+    void expect_matrix(const matrix_row_t expected[MATRIX_ROWS]) {
+        matrix_scan();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            EXPECT_EQ(matrix_get_row(row), expected[row]) << "row " << (int)row;
+        }
+    }
+};
+
+TEST_F(MatrixTest, NothingPressed) {
+    matrix_row_t rows[MATRIX_ROWS] = {0};
+    matrix_row_t expected[MATRIX_ROWS];
+    press(rows, expected);
+    expect_matrix(expected);
+}
+
+TEST_F(MatrixTest, EachKeyAlone) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_row_t rows[MATRIX_ROWS] = {0};
+            matrix_row_t expected[MATRIX_ROWS];
+            rows[row] = (matrix_row_t)1 << col;
+            press(rows, expected);
+            expect_matrix(expected);
+        }
+    }
+}
+
+TEST_F(MatrixTest, WholeRow) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t rows[MATRIX_ROWS] = {0};
+        matrix_row_t expected[MATRIX_ROWS];
+        rows[row] = ~(matrix_row_t)0;
+        press(rows, expected);
+        expect_matrix(expected);
+    }
+}
+
+TEST_F(MatrixTest, RandomKeys) {
+    std::mt19937 rng(42);
+    for (int i = 0; i < 500; i++) {
+        matrix_row_t rows[MATRIX_ROWS];
+        matrix_row_t expected[MATRIX_ROWS];
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            // a sparse and a dense row every now and then
+            rows[row] = rng() & rng() & (i % 3 ? rng() : ~(matrix_row_t)0);
+        }
+        press(rows, expected);
+        expect_matrix(expected);
+    }
+}
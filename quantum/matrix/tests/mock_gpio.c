@@ -0,0 +1,59 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "mock_gpio.h"
+
+#define MOCK_PIN_COUNT (MOCK_PORT_COUNT * 16)
+
+volatile uint8_t mock_pin_regs[MOCK_PORT_COUNT];
+
+static bool pin_output[MOCK_PIN_COUNT];
+static bool pin_high[MOCK_PIN_COUNT];
+static bool pressed[MOCK_PIN_COUNT][MOCK_PIN_COUNT];
+
+// inputs are pulled up, unless a pressed key connects them to an output driven low
+static void mock_gpio_update(void) {
+    for (pin_t pin = 0; pin < MOCK_PIN_COUNT; pin++) {
+        bool high = pin_high[pin];
+        if (!pin_output[pin]) {
+            high = true;
+            for (pin_t other = 0; other < MOCK_PIN_COUNT; other++) {
+                if (pressed[other][pin] && pin_output[other] && !pin_high[other]) {
+                    high = false;
+                }
+            }
+        }
+
+        if (high) {
+            mock_pin_regs[pin >> 4] |= _BV(pin & 0xF);
+        } else {
+            mock_pin_regs[pin >> 4] &= ~_BV(pin & 0xF);
+        }
+    }
+}
+
+void mock_gpio_reset(void) {
+    memset(pin_output, 0, sizeof(pin_output));
+    memset(pin_high, 0, sizeof(pin_high));
+    memset(pressed, 0, sizeof(pressed));
+    mock_gpio_update();
+}
+
+void mock_gpio_press(pin_t row_pin, pin_t col_pin, bool state) {
+    pressed[row_pin][col_pin] = state;
+    mock_gpio_update();
+}
+
+void mock_gpio_set_output(pin_t pin, bool output) {
+    pin_output[pin] = output;
+    if (!output) {
+        pin_high[pin] = true;
+    }
+    mock_gpio_update();
+}
+
+void mock_gpio_write(pin_t pin, bool high) {
+    pin_high[pin] = high;
+    mock_gpio_update();
+}
@@ -0,0 +1,11 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "gpio.h"
+
+// the keys held down, by row and column pin
+void mock_gpio_reset(void);
+void mock_gpio_press(pin_t row_pin, pin_t col_pin, bool pressed);
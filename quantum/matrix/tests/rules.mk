@@ -0,0 +1,26 @@
+MATRIX_COMMON_DEFS := -DIGNORE_ATOMIC_BLOCK
+
+MATRIX_COMMON_SRC := \
+	$(QUANTUM_PATH)/matrix/tests/mock_gpio.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests.cpp \
+	$(QUANTUM_PATH)/matrix.c \
+	$(QUANTUM_PATH)/matrix_common.c \
+	$(QUANTUM_PATH)/bitwise.c \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+# the same pinout read port by port and pin by pin
+matrix_col_port_read_DEFS := $(MATRIX_COMMON_DEFS) -DMATRIX_COL_PORT_READ
+matrix_col_port_read_INC := $(QUANTUM_PATH)/matrix/tests
+matrix_col_port_read_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_lele76.h
+matrix_col_port_read_SRC := $(MATRIX_COMMON_SRC)
+
+matrix_col_pin_read_DEFS := $(MATRIX_COMMON_DEFS)
+matrix_col_pin_read_INC := $(QUANTUM_PATH)/matrix/tests
+matrix_col_pin_read_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_lele76.h
+matrix_col_pin_read_SRC := $(MATRIX_COMMON_SRC)
+
+matrix_col_port_read_mixed_DEFS := $(MATRIX_COMMON_DEFS) -DMATRIX_COL_PORT_READ
+matrix_col_port_read_mixed_INC := $(QUANTUM_PATH)/matrix/tests
+matrix_col_port_read_mixed_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mixed.h
+matrix_col_port_read_mixed_SRC := $(MATRIX_COMMON_SRC)
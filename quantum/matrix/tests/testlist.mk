@@ -0,0 +1,4 @@
+TEST_LIST += \
+	matrix_col_port_read \
+	matrix_col_pin_read \
+	matrix_col_port_read_mixed
@@ -4,6 +4,7 @@
 #include "wait.h"
 #include "print.h"
 #include "debug.h"
+#include "task_profiler.h"
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -167,6 +168,9 @@ __attribute__((weak)) void matrix_init(void) {
 
 __attribute__((weak)) uint8_t matrix_scan(void) {
     bool changed = matrix_scan_custom(raw_matrix);
+    if (changed) {
+        task_profiler_raw_changed();
+    }
 
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
@@ -88,53 +88,73 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#if COMBO_INDEX_SIZE > 0
+/* Every key of every combo, sorted by keycode and then by combo index, so a key event
+ * only checks the combos it is part of. Built from combo_get() on the first key event.
+ * Each entry keeps the bit of the key in the combo's state and the number of keys, a
+ * combo is then matched without reading its keys again.
+ * The keycodes that reached a combo since the last clear_combos() are remembered too,
+ * only their combos can need a reset.
+ */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+    uint8_t  key_index;
+    uint8_t  key_count;
+} combo_index_entry_t;
+
+typedef enum {
+    COMBO_INDEX_STALE,
+    COMBO_INDEX_READY,
+    COMBO_INDEX_TOO_SMALL,
+} combo_index_state_t;
+
+static combo_index_entry_t combo_index[COMBO_INDEX_SIZE];
+static uint16_t            combo_index_length = 0;
+static combo_index_state_t combo_index_state  = COMBO_INDEX_STALE;
+
+#    define COMBO_TOUCHED_LENGTH (COMBO_KEY_BUFFER_LENGTH * 2)
+static uint16_t combo_touched[COMBO_TOUCHED_LENGTH];
+static uint8_t  combo_touched_count = 0;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
-/* flags are their own elements in combo_t struct. */
-#    define COMBO_ACTIVE(combo) (combo->active)
-#    define COMBO_DISABLED(combo) (combo->disabled)
+/* flags are their own byte in combo_t struct. */
+#    define COMBO_FLAGS(combo) (combo->flags)
 #    define COMBO_STATE(combo) (combo->state)
 
-#    define ACTIVATE_COMBO(combo) \
-        do {                      \
-            combo->active = true; \
-        } while (0)
-#    define DEACTIVATE_COMBO(combo) \
-        do {                        \
-            combo->active = false;  \
-        } while (0)
-#    define DISABLE_COMBO(combo)    \
-        do {                        \
-            combo->disabled = true; \
-        } while (0)
 #    define RESET_COMBO_STATE(combo) \
         do {                         \
-            combo->disabled = false; \
-            combo->state    = 0;     \
+            combo->flags &= ~0x40;   \
+            combo->state = 0;        \
         } while (0)
 #else
 /* flags are at the two high bits of state. */
-#    define COMBO_ACTIVE(combo) (combo->state & 0x80)
-#    define COMBO_DISABLED(combo) (combo->state & 0x40)
+#    define COMBO_FLAGS(combo) (combo->state)
 #    define COMBO_STATE(combo) (combo->state & 0x3F)
 
-#    define ACTIVATE_COMBO(combo) \
-        do {                      \
-            combo->state |= 0x80; \
-        } while (0)
-#    define DEACTIVATE_COMBO(combo) \
-        do {                        \
-            combo->state &= ~0x80;  \
-        } while (0)
-#    define DISABLE_COMBO(combo)  \
-        do {                      \
-            combo->state |= 0x40; \
-        } while (0)
 #    define RESET_COMBO_STATE(combo) \
         do {                         \
             combo->state &= ~0x7F;   \
         } while (0)
 #endif
 
+#define COMBO_ACTIVE(combo) (COMBO_FLAGS(combo) & 0x80)
+#define COMBO_DISABLED(combo) (COMBO_FLAGS(combo) & 0x40)
+
+#define ACTIVATE_COMBO(combo)       \
+    do {                            \
+        COMBO_FLAGS(combo) |= 0x80; \
+    } while (0)
+#define DEACTIVATE_COMBO(combo)      \
+    do {                             \
+        COMBO_FLAGS(combo) &= ~0x80; \
+    } while (0)
+#define DISABLE_COMBO(combo)        \
+    do {                            \
+        COMBO_FLAGS(combo) |= 0x40; \
+    } while (0)
+
 static inline void release_combo(uint16_t combo_index, combo_t *combo) {
     if (combo->keycode) {
         keyrecord_t record = {
@@ -185,14 +205,116 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
     return COMBO_TERM;
 }
 
+#if COMBO_INDEX_SIZE > 0
+void combo_index_invalidate(void) {
+    combo_index_state = COMBO_INDEX_STALE;
+    // combos touched under the old index are not found through the new one
+    combo_touched_count = COMBO_TOUCHED_LENGTH + 1;
+}
+
+static bool combo_index_build(void) {
+    if (combo_index_state != COMBO_INDEX_STALE) {
+        return combo_index_state == COMBO_INDEX_READY;
+    }
+
+    combo_index_length = 0;
+    for (uint16_t index = 0; index < combo_count(); ++index) {
+        const uint16_t *keys      = combo_get(index)->keys;
+        uint8_t         key_count = 0;
+
+        while (pgm_read_word(&keys[key_count]) != COMBO_END) {
+            key_count++;
+        }
+
+        for (uint8_t key = 0; key < key_count; key++) {
+            // a key listed twice in a combo is checked once, with its last bit
+            uint16_t keycode = pgm_read_word(&keys[key]);
+            uint8_t  after   = key + 1;
+            while (after < key_count && pgm_read_word(&keys[after]) != keycode) {
+                after++;
+            }
+            if (after < key_count) {
+                continue;
+            }
+            if (combo_index_length == COMBO_INDEX_SIZE) {
+                combo_index_state = COMBO_INDEX_TOO_SMALL;
+                return false;
+            }
+
+            // combos are added in order, ties on the keycode keep it
+            uint16_t i = combo_index_length++;
+            for (; i > 0 && combo_index[i - 1].keycode > keycode; i--) {
+                combo_index[i] = combo_index[i - 1];
+            }
+            combo_index[i] = (combo_index_entry_t){
+                .keycode     = keycode,
+                .combo_index = index,
+                .key_index   = key,
+                .key_count   = key_count,
+            };
+        }
+    }
+
+    combo_index_state = COMBO_INDEX_READY;
+    return true;
+}
+
+/* The first entry of a keycode, or where it would be */
+static uint16_t combo_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_index_length;
+    while (low < high) {
+        uint16_t middle = low + (high - low) / 2;
+        if (combo_index[middle].keycode < keycode) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void combo_touch(uint16_t keycode) {
+    for (uint8_t i = 0; i < combo_touched_count && i < COMBO_TOUCHED_LENGTH; i++) {
+        if (combo_touched[i] == keycode) {
+            return;
+        }
+    }
+    if (combo_touched_count < COMBO_TOUCHED_LENGTH) {
+        combo_touched[combo_touched_count] = keycode;
+    }
+    // past the end every combo gets reset
+    if (combo_touched_count <= COMBO_TOUCHED_LENGTH) {
+        combo_touched_count++;
+    }
+}
+#else
+void combo_index_invalidate(void) {}
+#endif
+
+static inline void reset_combo(combo_t *combo) {
+    if (!COMBO_ACTIVE(combo)) {
+        RESET_COMBO_STATE(combo);
+    }
+}
+
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
-    for (index = 0; index < combo_count(); ++index) {
-        combo_t *combo = combo_get(index);
-        if (!COMBO_ACTIVE(combo)) {
-            RESET_COMBO_STATE(combo);
+#if COMBO_INDEX_SIZE > 0
+    if (combo_index_state == COMBO_INDEX_READY && combo_touched_count <= COMBO_TOUCHED_LENGTH) {
+        for (uint8_t i = 0; i < combo_touched_count; i++) {
+            uint16_t keycode = combo_touched[i];
+            for (uint16_t entry = combo_index_find(keycode); entry < combo_index_length && combo_index[entry].keycode == keycode; entry++) {
+                reset_combo(combo_get(combo_index[entry].combo_index));
+            }
         }
+        combo_touched_count = 0;
+        return;
+    }
+    combo_touched_count = 0;
+#endif
+    for (index = 0; index < combo_count(); ++index) {
+        reset_combo(combo_get(index));
     }
 }
 
@@ -250,7 +372,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -272,6 +393,32 @@ static inline void _find_key_index_and_count(const uint16_t *keys, uint16_t keyc
     }
 }
 
+/* The bit of a key in the state of a combo, false if the key is not part of the combo.
+ * Taken from the index when there is one, otherwise from the combo's keys. */
+static bool combo_key_position(uint16_t idx, combo_t *combo, uint16_t keycode, uint8_t *key_index, uint8_t *key_count) {
+#if COMBO_INDEX_SIZE > 0
+    if (combo_index_build()) {
+        for (uint16_t entry = combo_index_find(keycode); entry < combo_index_length && combo_index[entry].keycode == keycode; entry++) {
+            if (combo_index[entry].combo_index == idx) {
+                *key_index = combo_index[entry].key_index;
+                *key_count = combo_index[entry].key_count;
+                return true;
+            }
+        }
+        return false;
+    }
+#endif
+    uint16_t index = -1;
+    uint8_t  count = 0;
+    _find_key_index_and_count(combo->keys, keycode, &index, &count);
+    if (-1 == (int16_t)index) {
+        return false;
+    }
+    *key_index = index;
+    *key_count = count;
+    return true;
+}
+
 void drop_combo_from_buffer(uint16_t combo_index) {
     /* Mark a combo as processed from the buffer. If the buffer is in the
      * beginning of the buffer, drop it.  */
@@ -314,11 +461,8 @@ void apply_combo(uint16_t combo_index, combo_t *combo) {
         keyrecord_t *    record  = &qrecord->record;
         uint16_t         keycode = qrecord->keycode;
 
-        uint8_t  key_count = 0;
-        uint16_t key_index = -1;
-        _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-        if (-1 == (int16_t)key_index) {
+        uint8_t key_index, key_count;
+        if (!combo_key_position(combo_index, combo, keycode, &key_index, &key_count)) {
             // key not part of this combo
             continue;
         }
@@ -387,7 +531,7 @@ combo_t *overlaps(combo_t *combo1, combo_t *combo2) {
 }
 
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
-static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t key_index, uint16_t keycode, keyrecord_t *record) {
+static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint8_t key_index, uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_MUST_PRESS_IN_ORDER_PER_COMBO
     if (!get_combo_must_press_in_order(combo_index, combo)) {
         return true;
@@ -408,16 +552,7 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
-    uint8_t  key_count = 0;
-    uint16_t key_index = -1;
-    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-    /* Continue processing if key isn't part of current combo. */
-    if (-1 == (int16_t)key_index) {
-        return false;
-    }
-
+static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index, uint8_t key_index, uint8_t key_count) {
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
                                  && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
@@ -529,8 +664,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -558,10 +692,29 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#if COMBO_INDEX_SIZE > 0
+    if (combo_index_build()) {
+        uint16_t entry = combo_index_find(keycode);
+        if (entry < combo_index_length && combo_index[entry].keycode == keycode) {
+            combo_touch(keycode);
+        }
+        for (; entry < combo_index_length && combo_index[entry].keycode == keycode; entry++) {
+            combo_index_entry_t *key = &combo_index[entry];
+            is_combo_key |= process_single_combo(combo_get(key->combo_index), keycode, record, key->combo_index, key->key_index, key->key_count);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            uint8_t  key_index, key_count;
+
+            /* Continue processing if key isn't part of current combo. */
+            if (!combo_key_position(idx, combo, keycode, &key_index, &key_count)) {
+                continue;
+            }
+            is_combo_key |= process_single_combo(combo, keycode, record, idx, key_index, key_count);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
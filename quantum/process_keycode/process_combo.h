@@ -37,14 +37,19 @@
 #    define COMBO_BUFFER_LENGTH 4
 #endif
 
+/* combo keys looked up by keycode, 6 bytes of RAM per entry. Off by default, keymaps
+ * opt in with a size of at least the number of keys in all their combos. */
+#ifndef COMBO_INDEX_SIZE
+#    define COMBO_INDEX_SIZE 0
+#endif
+
 typedef struct combo_t {
     const uint16_t *keys;
     uint16_t        keycode;
 #ifdef EXTRA_SHORT_COMBOS
     uint8_t state;
 #else
-    bool     disabled;
-    bool     active;
+    uint8_t flags;
 #    if defined(EXTRA_EXTRA_LONG_COMBOS)
     uint32_t state;
 #    elif defined(EXTRA_LONG_COMBOS)
@@ -75,6 +80,8 @@ bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
+void combo_index_invalidate(void);
+
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
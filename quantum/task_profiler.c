@@ -0,0 +1,313 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "task_profiler.h"
+#include "timer.h"
+#include "print.h"
+#include "progmem.h"
+
+#if defined(__AVR__)
+#    include <avr/io.h>
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#    define TASK_PROFILER_CLOCK TIMER_RAW_FREQ
+#elif defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+#if defined(PROTOCOL_CHIBIOS) && (PORT_SUPPORTS_RT == TRUE)
+// the realtime counter, only there when the port has a cycle counter
+#    define TASK_PROFILER_RT_COUNTER
+#    define TASK_PROFILER_CLOCK 1000000
+#elif !defined(__AVR__)
+// timer_read32(), milliseconds
+#    define TASK_PROFILER_CLOCK 1000
+#endif
+
+#ifndef TASK_PROFILER_INTERVAL
+#    define TASK_PROFILER_INTERVAL 10000
+#endif
+
+// Durations are binned by bit length: bucket n holds the durations of n bits, the last
+// bucket everything longer. The histogram, sum and count are halved when the count fills up.
+#ifndef TASK_PROFILER_BUCKETS
+#    define TASK_PROFILER_BUCKETS 12
+#endif
+
+typedef struct {
+    uint32_t sum; // ticks
+    uint16_t count;
+    uint16_t min; // ticks
+    uint16_t max; // ticks
+    uint16_t buckets[TASK_PROFILER_BUCKETS];
+} task_profile_t;
+
+static task_profile_t task_profiles[TASK_PROFILER_COUNT];
+
+#define TASK_PROFILER_NAME_SIZE 10
+
+static const char task_profiler_names[TASK_PROFILER_COUNT][TASK_PROFILER_NAME_SIZE] PROGMEM = {
+    [TASK_PROFILER_LOOP]     = "loop",
+    [TASK_PROFILER_KEYBOARD] = "keyboard",
+    [TASK_PROFILER_MATRIX]   = "matrix",
+    [TASK_PROFILER_QUANTUM]  = "quantum",
+#ifdef RGBLIGHT_ENABLE
+    [TASK_PROFILER_RGBLIGHT] = "rgblight",
+#endif
+#ifdef LED_MATRIX_ENABLE
+    [TASK_PROFILER_LED_MATRIX] = "ledmatrix",
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    [TASK_PROFILER_RGB_MATRIX] = "rgbmatrix",
+#endif
+#ifdef BACKLIGHT_ENABLE
+    [TASK_PROFILER_BACKLIGHT] = "backlight",
+#endif
+#ifdef ENCODER_ENABLE
+    [TASK_PROFILER_ENCODER] = "encoder",
+#endif
+#ifdef POINTING_DEVICE_ENABLE
+    [TASK_PROFILER_POINTING_DEVICE] = "pointing",
+#endif
+#ifdef OLED_ENABLE
+    [TASK_PROFILER_OLED] = "oled",
+#endif
+#ifdef ST7565_ENABLE
+    [TASK_PROFILER_ST7565] = "st7565",
+#endif
+#ifdef MOUSEKEY_ENABLE
+    [TASK_PROFILER_MOUSEKEY] = "mousekey",
+#endif
+    [TASK_PROFILER_LED] = "led",
+#ifdef QUANTUM_PAINTER_ENABLE
+    [TASK_PROFILER_QUANTUM_PAINTER] = "painter",
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+    [TASK_PROFILER_DEFERRED_EXEC] = "deferred",
+#endif
+    [TASK_PROFILER_HOUSEKEEPING] = "housekeep",
+#ifdef TASK_PROFILER_LATENCY
+    [TASK_PROFILER_DEBOUNCE_DELAY] = "debounce",
+    [TASK_PROFILER_PROCESS_DELAY]  = "process",
+    [TASK_PROFILER_USB_DELAY]      = "usb",
+#endif
+};
+
+#if defined(__AVR__)
+extern volatile uint32_t timer_count;
+
+#    if defined(__AVR_ATmega32A__)
+#        define TIMER_RAW_PENDING (TIFR & _BV(OCF0))
+#    elif defined(__AVR_ATtiny85__)
+#        define TIMER_RAW_PENDING (TIFR & _BV(OCF0A))
+#    else
+#        define TIMER_RAW_PENDING (TIFR0 & _BV(OCF0A))
+#    endif
+
+uint32_t task_profiler_timestamp(void) {
+    uint32_t ms;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+        // the counter restarted but the millisecond interrupt has not run yet
+        if (TIMER_RAW_PENDING) {
+            ms++;
+            raw = TIMER_RAW;
+        }
+    }
+    return ms * (TIMER_RAW_TOP + 1) + raw;
+}
+#elif defined(TASK_PROFILER_RT_COUNTER)
+uint32_t task_profiler_timestamp(void) {
+    return chSysGetRealtimeCounterX() / (REALTIME_COUNTER_CLOCK / TASK_PROFILER_CLOCK);
+}
+#else
+uint32_t task_profiler_timestamp(void) {
+    return timer_read32();
+}
+#endif
+
+void task_profiler_record(task_profiler_task_t task, uint32_t start) {
+    task_profile_t *profile  = &task_profiles[task];
+    uint32_t        elapsed  = task_profiler_timestamp() - start;
+    uint16_t        duration = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+
+    uint8_t bucket = 0;
+    for (uint16_t rest = duration; rest && bucket < TASK_PROFILER_BUCKETS - 1; rest >>= 1) {
+        bucket++;
+    }
+
+    if (profile->count == UINT16_MAX) {
+        for (uint8_t i = 0; i < TASK_PROFILER_BUCKETS; i++) {
+            profile->buckets[i] >>= 1;
+        }
+        profile->sum >>= 1;
+        profile->count >>= 1;
+    }
+    profile->buckets[bucket]++;
+
+    if (profile->count == 0 || duration < profile->min) {
+        profile->min = duration;
+    }
+    if (duration > profile->max) {
+        profile->max = duration;
+    }
+    profile->sum += duration;
+    profile->count++;
+}
+
+#ifdef TASK_PROFILER_LATENCY
+/* A key event only carries its timer_read() time. Events processed during the scan
+ * that made them start at the timestamp of that scan, older ones, held back by tapping
+ * or combos, at their millisecond. Each stage is timed from its first event or report
+ * until the next stage takes it, later ones in between are not sampled. Reports are
+ * numbered as they are queued, so a protocol that buffers them only ends the usb stage
+ * with the report that started it, or a later one. */
+static uint16_t latency_scan_time;
+static uint32_t latency_scan_start;
+static uint32_t latency_raw_start;
+static uint32_t latency_event_start;
+static uint32_t latency_report_start;
+static uint8_t  latency_report_seq;
+static uint8_t  latency_report_sample;
+static bool     latency_raw_pending    = false;
+static bool     latency_event_pending  = false;
+static bool     latency_report_pending = false;
+
+void task_profiler_raw_changed(void) {
+    if (!latency_raw_pending) {
+        latency_raw_start   = task_profiler_timestamp();
+        latency_raw_pending = true;
+    }
+}
+
+void task_profiler_matrix_scanned(bool changed) {
+    // reports made outside of the key events, by timers, are not charged to them
+    latency_event_pending = false;
+    if (!changed) {
+        return;
+    }
+
+    latency_scan_start = task_profiler_timestamp();
+    latency_scan_time  = timer_read();
+    if (latency_raw_pending) {
+        task_profiler_record(TASK_PROFILER_DEBOUNCE_DELAY, latency_raw_start);
+        latency_raw_pending = false;
+    }
+}
+
+void task_profiler_key_event(keyevent_t *event) {
+    if (event->time == latency_scan_time) {
+        latency_event_start = latency_scan_start;
+    } else {
+        latency_event_start = task_profiler_timestamp() - (uint32_t)timer_elapsed(event->time) * (TASK_PROFILER_CLOCK / 1000);
+    }
+    latency_event_pending = true;
+}
+
+void task_profiler_report_queued(void) {
+    latency_report_seq++;
+    if (latency_event_pending) {
+        task_profiler_record(TASK_PROFILER_PROCESS_DELAY, latency_event_start);
+        latency_event_pending = false;
+    }
+    if (!latency_report_pending) {
+        latency_report_start   = task_profiler_timestamp();
+        latency_report_sample  = latency_report_seq;
+        latency_report_pending = true;
+    }
+}
+
+uint8_t task_profiler_report_seq(void) {
+    return latency_report_seq;
+}
+
+void task_profiler_report_sent_seq(uint8_t seq) {
+    // reports queued before the sampled one are still ahead of it
+    if (latency_report_pending && (int8_t)(seq - latency_report_sample) >= 0) {
+        task_profiler_record(TASK_PROFILER_USB_DELAY, latency_report_start);
+        latency_report_pending = false;
+    }
+}
+
+void task_profiler_report_sent(void) {
+    task_profiler_report_sent_seq(latency_report_seq);
+}
+#endif
+
+static uint32_t ticks_to_us(uint32_t ticks) {
+#if TASK_PROFILER_CLOCK >= 1000000
+    return ticks / (TASK_PROFILER_CLOCK / 1000000);
+#else
+    return ticks * 1000 / (TASK_PROFILER_CLOCK / 1000);
+#endif
+}
+
+bool task_profiler_get(task_profiler_task_t task, task_profiler_stats_t *stats) {
+    memset(stats, 0, sizeof(task_profiler_stats_t));
+    if (task >= TASK_PROFILER_COUNT || task_profiles[task].count == 0) {
+        return false;
+    }
+
+    const task_profile_t *profile = &task_profiles[task];
+
+    // halving rounds every bucket down, rank the 99th percentile by their own total
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < TASK_PROFILER_BUCKETS; i++) {
+        total += profile->buckets[i];
+    }
+    uint32_t rank   = total - total / 100;
+    uint32_t seen   = 0;
+    uint8_t  bucket = 0;
+    while (bucket < TASK_PROFILER_BUCKETS - 1) {
+        seen += profile->buckets[bucket];
+        if (seen >= rank) {
+            break;
+        }
+        bucket++;
+    }
+    uint32_t p99 = ((uint32_t)1 << bucket) - 1;
+    if (bucket == TASK_PROFILER_BUCKETS - 1 || p99 > profile->max) {
+        p99 = profile->max;
+    }
+
+    stats->count = profile->count;
+    stats->min   = ticks_to_us(profile->min);
+    stats->avg   = ticks_to_us(profile->sum / profile->count);
+    stats->max   = ticks_to_us(profile->max);
+    stats->p99   = ticks_to_us(p99);
+    return true;
+}
+
+void task_profiler_reset(void) {
+    memset(task_profiles, 0, sizeof(task_profiles));
+}
+
+void task_profiler_print(void) {
+    task_profiler_stats_t stats;
+    char                  name[TASK_PROFILER_NAME_SIZE];
+
+    uprintf("task       count   min   avg   max   p99 (us)\n");
+    for (uint8_t task = 0; task < TASK_PROFILER_COUNT; task++) {
+        if (!task_profiler_get(task, &stats)) {
+            continue;
+        }
+        memcpy_P(name, task_profiler_names[task], sizeof(name));
+        uprintf("%-10s %5u %5lu %5lu %5lu %5lu\n", name, stats.count, stats.min, stats.avg, stats.max, stats.p99);
+    }
+    task_profiler_reset();
+}
+
+void task_profiler_task(void) {
+#if TASK_PROFILER_INTERVAL > 0
+    static uint32_t last_print = 0;
+
+    if (timer_elapsed32(last_print) >= TASK_PROFILER_INTERVAL) {
+        last_print = timer_read32();
+        task_profiler_print();
+    }
+#endif
+}
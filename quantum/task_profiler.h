@@ -0,0 +1,186 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Keeps min/avg/max/p99 durations of the tasks run by the main loop, in a fixed-size table.
+    Enabled with TASK_PROFILER_ENABLE = yes in rules.mk.
+
+    Reports over console every TASK_PROFILER_INTERVAL milliseconds, or on request with
+    task_profiler_print(). With VIA the same table can be queried over raw HID, see
+    via_qmk_task_profiler_command().
+
+    Other code can be profiled the same way:
+
+        TASK_PROFILE(TASK_PROFILER_OLED, oled_task());
+
+    With TASK_PROFILER_LATENCY defined, the table also keeps the delays a key goes through
+    on its way to the host: from the first raw matrix change to the debounced key event,
+    from the key event to the keyboard report that carries it (tapping and combos
+    included), and from that report to the USB endpoint.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+typedef enum {
+    TASK_PROFILER_LOOP,     // one pass of the main loop, including the USB protocol
+    TASK_PROFILER_KEYBOARD, // keyboard_task()
+    TASK_PROFILER_MATRIX,   // matrix scan and the key events it leads to
+    TASK_PROFILER_QUANTUM,
+#ifdef RGBLIGHT_ENABLE
+    TASK_PROFILER_RGBLIGHT,
+#endif
+#ifdef LED_MATRIX_ENABLE
+    TASK_PROFILER_LED_MATRIX,
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    TASK_PROFILER_RGB_MATRIX,
+#endif
+#ifdef BACKLIGHT_ENABLE
+    TASK_PROFILER_BACKLIGHT,
+#endif
+#ifdef ENCODER_ENABLE
+    TASK_PROFILER_ENCODER,
+#endif
+#ifdef POINTING_DEVICE_ENABLE
+    TASK_PROFILER_POINTING_DEVICE,
+#endif
+#ifdef OLED_ENABLE
+    TASK_PROFILER_OLED,
+#endif
+#ifdef ST7565_ENABLE
+    TASK_PROFILER_ST7565,
+#endif
+#ifdef MOUSEKEY_ENABLE
+    TASK_PROFILER_MOUSEKEY,
+#endif
+    TASK_PROFILER_LED,
+#ifdef QUANTUM_PAINTER_ENABLE
+    TASK_PROFILER_QUANTUM_PAINTER,
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+    TASK_PROFILER_DEFERRED_EXEC,
+#endif
+    TASK_PROFILER_HOUSEKEEPING,
+#ifdef TASK_PROFILER_LATENCY
+    TASK_PROFILER_DEBOUNCE_DELAY, // first raw matrix change to the debounced key event
+    TASK_PROFILER_PROCESS_DELAY,  // key event to the keyboard report it leads to
+    TASK_PROFILER_USB_DELAY,      // keyboard report to the USB endpoint
+#endif
+    TASK_PROFILER_COUNT
+} task_profiler_task_t;
+
+typedef struct {
+    uint16_t count; // samples since the last reset, halved when it fills up
+    uint32_t min;   // microseconds
+    uint32_t avg;   // microseconds
+    uint32_t max;   // microseconds
+    uint32_t p99;   // microseconds, rounded up to the next power of two timestamp ticks
+} task_profiler_stats_t;
+
+#ifdef TASK_PROFILER_ENABLE
+#    define TASK_PROFILE(task, ...)                                   \
+        do {                                                          \
+            uint32_t task_profiler_start = task_profiler_timestamp(); \
+            __VA_ARGS__;                                              \
+            task_profiler_record((task), task_profiler_start);        \
+        } while (0)
+#else
+#    define TASK_PROFILE(task, ...) \
+        do {                        \
+            __VA_ARGS__;            \
+        } while (0)
+#endif
+
+#if defined(TASK_PROFILER_ENABLE) && defined(TASK_PROFILER_LATENCY)
+/**
+ * @brief The raw matrix changed, called by the matrix scan before debouncing.
+ */
+void task_profiler_raw_changed(void);
+
+/**
+ * @brief The matrix was scanned, called by matrix_task().
+ *
+ * @param changed[in] true if the debounced matrix changed and key events follow
+ */
+void task_profiler_matrix_scanned(bool changed);
+
+/**
+ * @brief A key event is processed, called by process_record().
+ */
+void task_profiler_key_event(keyevent_t *event);
+
+/**
+ * @brief A keyboard report is handed to the host driver, called by host_keyboard_send().
+ */
+void task_profiler_report_queued(void);
+
+/**
+ * @brief The sequence number of the last keyboard report handed to the host driver.
+ *
+ * Protocols that buffer reports keep it with each one and pass it to
+ * task_profiler_report_sent_seq() when the report is written.
+ */
+uint8_t task_profiler_report_seq(void);
+
+/**
+ * @brief A buffered keyboard report is written to the USB endpoint, called by the protocol.
+ *
+ * @param seq[in] the task_profiler_report_seq() of the report, or of the last one merged into it
+ */
+void task_profiler_report_sent_seq(uint8_t seq);
+
+/**
+ * @brief The last keyboard report is written to the USB endpoint, called by the protocol.
+ */
+void task_profiler_report_sent(void);
+#else
+static inline void task_profiler_raw_changed(void) {}
+static inline void task_profiler_matrix_scanned(bool changed) {}
+static inline void task_profiler_key_event(keyevent_t *event) {}
+static inline void task_profiler_report_queued(void) {}
+static inline uint8_t task_profiler_report_seq(void) {
+    return 0;
+}
+static inline void task_profiler_report_sent_seq(uint8_t seq) {}
+static inline void task_profiler_report_sent(void) {}
+#endif
+
+/**
+ * @brief A free running timestamp in TASK_PROFILER_CLOCK ticks.
+ */
+uint32_t task_profiler_timestamp(void);
+
+/**
+ * @brief Adds a sample ending now to the statistics of a task.
+ *
+ * @param task[in] the task that ran
+ * @param start[in] task_profiler_timestamp() before the task ran
+ */
+void task_profiler_record(task_profiler_task_t task, uint32_t start);
+
+/**
+ * @brief Reads the statistics of a task.
+ *
+ * @param task[in] the task to read
+ * @param stats[out] the statistics, zeroed if the task has no samples
+ * @return true if the task has samples
+ */
+bool task_profiler_get(task_profiler_task_t task, task_profiler_stats_t *stats);
+
+/**
+ * @brief Clears the statistics of all tasks.
+ */
+void task_profiler_reset(void);
+
+/**
+ * @brief Prints the statistics of all tasks over console and clears them.
+ */
+void task_profiler_print(void);
+
+/**
+ * @brief Prints the statistics every TASK_PROFILER_INTERVAL milliseconds, run by the main loop.
+ */
+void task_profiler_task(void);
@@ -35,6 +35,10 @@
 #    include <lib/lib8tion/lib8tion.h>
 #endif
 
+#if defined(TASK_PROFILER_ENABLE)
+#    include "task_profiler.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -191,10 +195,11 @@ __attribute__((weak)) void via_custom_value_command_kb(uint8_t *data, uint8_t le
 // This is the default handler for custom value commands.
 // It routes commands with channel IDs to command handlers as such:
 //
-//      id_qmk_backlight_channel    ->  via_qmk_backlight_command()
-//      id_qmk_rgblight_channel     ->  via_qmk_rgblight_command()
-//      id_qmk_rgb_matrix_channel   ->  via_qmk_rgb_matrix_command()
-//      id_qmk_audio_channel        ->  via_qmk_audio_command()
+//      id_qmk_backlight_channel     ->  via_qmk_backlight_command()
+//      id_qmk_rgblight_channel      ->  via_qmk_rgblight_command()
+//      id_qmk_rgb_matrix_channel    ->  via_qmk_rgb_matrix_command()
+//      id_qmk_audio_channel         ->  via_qmk_audio_command()
+//      id_qmk_task_profiler_channel ->  via_qmk_task_profiler_command()
 //
 __attribute__((weak)) void via_custom_value_command(uint8_t *data, uint8_t length) {
     // data = [ command_id, channel_id, value_id, value_data ]
@@ -228,6 +233,13 @@ __attribute__((weak)) void via_custom_value_command(uint8_t *data, uint8_t lengt
     }
 #endif // AUDIO_ENABLE
 
+#if defined(TASK_PROFILER_ENABLE)
+    if (*channel_id == id_qmk_task_profiler_channel) {
+        via_qmk_task_profiler_command(data, length);
+        return;
+    }
+#endif // TASK_PROFILER_ENABLE
+
     (void)channel_id; // force use of variable
 
     // If we haven't returned before here, then let the keyboard level code
@@ -758,3 +770,60 @@ void via_qmk_audio_save(void) {
 }
 
 #endif // QMK_AUDIO_ENABLE
+
+#if defined(TASK_PROFILER_ENABLE)
+
+void via_qmk_task_profiler_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, channel_id, value_id, value_data ]
+    uint8_t *command_id        = &(data[0]);
+    uint8_t *value_id_and_data = &(data[2]);
+
+    switch (*command_id) {
+        case id_custom_set_value: {
+            via_qmk_task_profiler_set_value(value_id_and_data);
+            break;
+        }
+        case id_custom_get_value: {
+            via_qmk_task_profiler_get_value(value_id_and_data);
+            break;
+        }
+        case id_custom_save: {
+            // nothing is stored
+            break;
+        }
+        default: {
+            *command_id = id_unhandled;
+            break;
+        }
+    }
+}
+
+static void via_put_u32(uint8_t *data, uint32_t value) {
+    data[0] = value >> 24;
+    data[1] = value >> 16;
+    data[2] = value >> 8;
+    data[3] = value & 0xFF;
+}
+
+void via_qmk_task_profiler_get_value(uint8_t *data) {
+    // data = [ value_id, value_data ]
+    // value_id is a task_profiler_task_t, value_data = [ count (2), min, avg, max, p99 (4 each, us) ]
+    uint8_t              *value_id   = &(data[0]);
+    uint8_t              *value_data = &(data[1]);
+    task_profiler_stats_t stats;
+
+    task_profiler_get(*value_id, &stats);
+    value_data[0] = stats.count >> 8;
+    value_data[1] = stats.count & 0xFF;
+    via_put_u32(&value_data[2], stats.min);
+    via_put_u32(&value_data[6], stats.avg);
+    via_put_u32(&value_data[10], stats.max);
+    via_put_u32(&value_data[14], stats.p99);
+}
+
+void via_qmk_task_profiler_set_value(uint8_t *data) {
+    // any value clears the statistics of all tasks
+    task_profiler_reset();
+}
+
+#endif // TASK_PROFILER_ENABLE
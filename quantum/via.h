@@ -104,11 +104,12 @@ enum via_keyboard_value_id {
 };
 
 enum via_channel_id {
-    id_custom_channel         = 0,
-    id_qmk_backlight_channel  = 1,
-    id_qmk_rgblight_channel   = 2,
-    id_qmk_rgb_matrix_channel = 3,
-    id_qmk_audio_channel      = 4,
+    id_custom_channel            = 0,
+    id_qmk_backlight_channel     = 1,
+    id_qmk_rgblight_channel      = 2,
+    id_qmk_rgb_matrix_channel    = 3,
+    id_qmk_audio_channel         = 4,
+    id_qmk_task_profiler_channel = 5,
 };
 
 enum via_qmk_backlight_value {
@@ -187,4 +188,10 @@ void via_qmk_audio_command(uint8_t *data, uint8_t length);
 void via_qmk_audio_set_value(uint8_t *data);
 void via_qmk_audio_get_value(uint8_t *data);
 void via_qmk_audio_save(void);
+#endif
+
+#if defined(TASK_PROFILER_ENABLE)
+void via_qmk_task_profiler_command(uint8_t *data, uint8_t length);
+void via_qmk_task_profiler_set_value(uint8_t *data);
+void via_qmk_task_profiler_get_value(uint8_t *data);
 #endif
\ No newline at end of file
@@ -0,0 +1,160 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::SaveArg;
+
+class Report : public TestFixture {
+   protected:
+    // Presses the keys one scan loop apart, in order
+    void press_in_order(std::initializer_list<KeymapKey*> keys) {
+        for (auto key : keys) {
+            key->press();
+            run_one_scan_loop();
+        }
+    }
+
+    // Raw key slots of the last report sent, in the order the host sees them
+    std::vector<uint8_t> slots() {
+        return std::vector<uint8_t>(sent.keys, sent.keys + KEYBOARD_REPORT_KEYS);
+    }
+
+    report_keyboard_t sent = {};
+};
+
+TEST_F(Report, KeysFillSlotsInPressOrder) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_ANY_REPORT(driver).Times(3).WillRepeatedly(SaveArg<0>(&sent));
+    press_in_order({&key_c, &key_a, &key_b});
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(slots(), std::vector<uint8_t>({KC_C, KC_A, KC_B, 0, 0, 0}));
+
+    EXPECT_ANY_REPORT(driver).Times(3);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Report, ReleasedSlotIsReusedFirst) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+
+    set_keymap({key_a, key_b, key_c, key_d});
+
+    EXPECT_ANY_REPORT(driver).Times(3);
+    press_in_order({&key_a, &key_b, &key_c});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_C)).WillOnce(SaveArg<0>(&sent));
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(slots(), std::vector<uint8_t>({KC_A, 0, KC_C, 0, 0, 0}));
+
+    EXPECT_REPORT(driver, (KC_A, KC_C, KC_D)).WillOnce(SaveArg<0>(&sent));
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(slots(), std::vector<uint8_t>({KC_A, KC_D, KC_C, 0, 0, 0}));
+
+    EXPECT_ANY_REPORT(driver).Times(3);
+    key_a.release();
+    key_c.release();
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Report, SeventhKeyIsDroppedUntilASlotFrees) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+    auto       key_e = KeymapKey(0, 4, 0, KC_E);
+    auto       key_f = KeymapKey(0, 5, 0, KC_F);
+    auto       key_g = KeymapKey(0, 6, 0, KC_G);
+    auto       key_h = KeymapKey(0, 7, 0, KC_H);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f, key_g, key_h});
+
+    EXPECT_ANY_REPORT(driver).Times(6);
+    press_in_order({&key_a, &key_b, &key_c, &key_d, &key_e, &key_f});
+    VERIFY_AND_CLEAR(driver);
+
+    // the report is full and does not change
+    EXPECT_NO_REPORT(driver);
+    key_g.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_D, KC_E, KC_F));
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_D, KC_E, KC_F, KC_H)).WillOnce(SaveArg<0>(&sent));
+    key_h.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(slots(), std::vector<uint8_t>({KC_A, KC_B, KC_H, KC_D, KC_E, KC_F}));
+
+    EXPECT_ANY_REPORT(driver).Times(6);
+    key_a.release();
+    key_b.release();
+    key_d.release();
+    key_e.release();
+    key_f.release();
+    key_g.release();
+    key_h.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Report, UnchangedReportIsNotSent) {
+    TestDriver driver;
+    auto       key_a1 = KeymapKey(0, 0, 0, KC_A);
+    auto       key_a2 = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key_a1, key_a2});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a1.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // a key already down is released first, so the host sees it pressed again
+    {
+        testing::InSequence s;
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_A));
+    }
+    key_a2.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // the first release takes the key out of the report, the second changes nothing
+    EXPECT_EMPTY_REPORT(driver);
+    key_a2.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_a1.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,122 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+static uint32_t combos_checked = 0;
+
+extern "C" {
+#include "keymap_introspection.h"
+
+combo_t *combo_get(uint16_t combo_idx) {
+    combos_checked++;
+    return combo_get_raw(combo_idx);
+}
+}
+
+class ComboIndex : public TestFixture {
+   protected:
+    std::vector<KeymapKey> keys;
+
+    ComboIndex() {
+        const uint16_t keycodes[] = {
+            KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M, KC_N, KC_O, KC_P,   // in 16 combos each
+            KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0, KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, // in 16 combos each
+            KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X,                                                     // in none
+        };
+        for (uint8_t i = 0; i < sizeof(keycodes) / sizeof(keycodes[0]); i++) {
+            keys.emplace_back(0, i % MATRIX_COLS, i / MATRIX_COLS, keycodes[i]);
+        }
+        for (auto &key : keys) {
+            add_key(key);
+        }
+    }
+
+    KeymapKey &key(uint16_t keycode) {
+        for (auto &key : keys) {
+            if (key.code == keycode) {
+                return key;
+            }
+        }
+        ADD_FAILURE() << "no key for keycode " << keycode;
+        return keys.front();
+    }
+
+    // Taps a key after the combo term of the last one, counting the combos checked
+    uint32_t checks_for_tap(KeymapKey &key) {
+        idle_for(COMBO_TERM + 1);
+        combos_checked = 0;
+        tap_key(key);
+        idle_for(COMBO_TERM + 1);
+        return combos_checked;
+    }
+};
+
+TEST_F(ComboIndex, CombosStillFire) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key(KC_P), key(KC_F6)});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key(KC_1), key(KC_A)});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, KeyInNoComboChecksNone) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    checks_for_tap(key(KC_Q));
+    EXPECT_EQ(checks_for_tap(key(KC_Q)), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, KeyChecksItsOwnCombosOnly) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    checks_for_tap(key(KC_A));
+    // on press, on release and to reset them afterwards, out of 256 combos
+    EXPECT_LE(checks_for_tap(key(KC_A)), 3 * 16);
+    EXPECT_LE(checks_for_tap(key(KC_F3)), 3 * 16);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, CostPerKeyEvent) {
+    TestDriver   driver;
+    std::mt19937 rng{0xC0FFEE};
+    const int    taps = 2000;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    checks_for_tap(key(KC_Q));
+
+    combos_checked = 0;
+    auto start     = std::chrono::steady_clock::now();
+    for (int i = 0; i < taps; i++) {
+        tap_key(keys[rng() % keys.size()]);
+        idle_for(COMBO_TERM + 1);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    RecordProperty("combos_checked_per_event", combos_checked / (taps * 2));
+    RecordProperty("ns_per_event", elapsed / (taps * 2));
+    // a scan of every combo on every event would be 256 and more
+    EXPECT_LE(combos_checked / (taps * 2), 16 * 3 / 2);
+    VERIFY_AND_CLEAR(driver);
+}
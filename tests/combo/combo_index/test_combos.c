@@ -0,0 +1,37 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+/* 256 combos, one for every pair of a letter from KC_A to KC_P and a key from KC_1 to KC_F6.
+ * Every one of those keys is part of 16 combos, the other keys of none.
+ */
+
+// clang-format off
+#define COMBO_KEYS_ROW(letter) \
+    const uint16_t PROGMEM letter##_combos[][3] = { \
+        {letter, KC_1, COMBO_END}, {letter, KC_2, COMBO_END}, {letter, KC_3, COMBO_END}, {letter, KC_4, COMBO_END}, \
+        {letter, KC_5, COMBO_END}, {letter, KC_6, COMBO_END}, {letter, KC_7, COMBO_END}, {letter, KC_8, COMBO_END}, \
+        {letter, KC_9, COMBO_END}, {letter, KC_0, COMBO_END}, {letter, KC_F1, COMBO_END}, {letter, KC_F2, COMBO_END}, \
+        {letter, KC_F3, COMBO_END}, {letter, KC_F4, COMBO_END}, {letter, KC_F5, COMBO_END}, {letter, KC_F6, COMBO_END}, \
+    };
+
+#define COMBOS_ROW(letter) \
+    COMBO(letter##_combos[0], KC_Z), COMBO(letter##_combos[1], KC_Z), COMBO(letter##_combos[2], KC_Z), COMBO(letter##_combos[3], KC_Z), \
+    COMBO(letter##_combos[4], KC_Z), COMBO(letter##_combos[5], KC_Z), COMBO(letter##_combos[6], KC_Z), COMBO(letter##_combos[7], KC_Z), \
+    COMBO(letter##_combos[8], KC_Z), COMBO(letter##_combos[9], KC_Z), COMBO(letter##_combos[10], KC_Z), COMBO(letter##_combos[11], KC_Z), \
+    COMBO(letter##_combos[12], KC_Z), COMBO(letter##_combos[13], KC_Z), COMBO(letter##_combos[14], KC_Z), COMBO(letter##_combos[15], KC_Z)
+
+#define FOR_EACH_LETTER(X, SEP) \
+    X(KC_A) SEP X(KC_B) SEP X(KC_C) SEP X(KC_D) SEP X(KC_E) SEP X(KC_F) SEP X(KC_G) SEP X(KC_H) SEP \
+    X(KC_I) SEP X(KC_J) SEP X(KC_K) SEP X(KC_L) SEP X(KC_M) SEP X(KC_N) SEP X(KC_O) SEP X(KC_P)
+
+#define NOTHING
+#define COMMA ,
+
+FOR_EACH_LETTER(COMBO_KEYS_ROW, NOTHING)
+
+combo_t key_combos[] = {
+    FOR_EACH_LETTER(COMBOS_ROW, COMMA)
+};
+// clang-format on
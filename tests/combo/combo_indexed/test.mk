@@ -0,0 +1,10 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# The combo tests again, with the keycode index instead of the full scan
+
+COMBO_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = ../test_combos.c
+
+SRC += ../test_combo.cpp
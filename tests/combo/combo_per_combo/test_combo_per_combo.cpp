@@ -0,0 +1,124 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class ComboPerCombo : public TestFixture {};
+
+TEST_F(ComboPerCombo, ShortTermFiresWithinIt) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboPerCombo, ShortTermRunsOut) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    /* A combo timer read at 0 counts as stopped, start the test later. */
+    run_one_scan_loop();
+
+    /* Slower than the 20ms of the combo, it is typed as two keys. */
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_b.press();
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboPerCombo, LongTermFiresLate) {
+    TestDriver driver;
+    KeymapKey  key_c(0, 2, 0, KC_C);
+    KeymapKey  key_d(0, 3, 0, KC_D);
+    set_keymap({key_c, key_d});
+
+    EXPECT_NO_REPORT(driver);
+    key_c.press();
+    idle_for(80);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    key_d.press();
+    idle_for(120);
+    key_c.release();
+    run_one_scan_loop();
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboPerCombo, MustHoldComboTappedTypesItsKeys) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_e(0, 4, 0, KC_E);
+    KeymapKey  key_f(0, 5, 0, KC_F);
+    set_keymap({key_e, key_f});
+
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_REPORT(driver, (KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_e, key_f});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboPerCombo, MustHoldComboHeldFires) {
+    TestDriver driver;
+    KeymapKey  key_e(0, 4, 0, KC_E);
+    KeymapKey  key_f(0, 5, 0, KC_F);
+    set_keymap({key_e, key_f});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_e, key_f}, COMBO_HOLD_TERM + 10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboPerCombo, LongerOverlappingComboWins) {
+    TestDriver driver;
+    KeymapKey  key_g(0, 6, 0, KC_G);
+    KeymapKey  key_h(0, 7, 0, KC_H);
+    KeymapKey  key_i(0, 8, 0, KC_I);
+    set_keymap({key_g, key_h, key_i});
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_g, key_h, key_i});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_W));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_g, key_h});
+    VERIFY_AND_CLEAR(driver);
+}
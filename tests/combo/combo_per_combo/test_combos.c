@@ -0,0 +1,36 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { quick, slow, hold, triple, pair };
+
+uint16_t const quick_combo[]  = {KC_A, KC_B, COMBO_END};
+uint16_t const slow_combo[]   = {KC_C, KC_D, COMBO_END};
+uint16_t const hold_combo[]   = {KC_E, KC_F, COMBO_END};
+uint16_t const triple_combo[] = {KC_G, KC_H, KC_I, COMBO_END};
+uint16_t const pair_combo[]   = {KC_G, KC_H, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [quick]  = COMBO(quick_combo, KC_X),
+    [slow]   = COMBO(slow_combo, KC_Y),
+    [hold]   = COMBO(hold_combo, KC_LSFT),
+    [triple] = COMBO(triple_combo, KC_Z),
+    [pair]   = COMBO(pair_combo, KC_W),
+};
+// clang-format on
+
+uint16_t get_combo_term(uint16_t index, combo_t *combo) {
+    switch (index) {
+        case quick:
+            return 20;
+        case slow:
+            return 100;
+    }
+    return COMBO_TERM;
+}
+
+bool get_combo_must_hold(uint16_t index, combo_t *combo) {
+    return index == hold;
+}
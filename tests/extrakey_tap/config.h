@@ -0,0 +1,9 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define USB_POLLING_INTERVAL_MS 10
+#define EXTRA_TAP_QUEUE_ENABLE
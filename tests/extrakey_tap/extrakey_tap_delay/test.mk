@@ -0,0 +1,8 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# The extra key tap tests again, with a TAP_CODE_DELAY for the keyboard keycodes
+
+EXTRAKEY_ENABLE = yes
+
+SRC += ../test_extrakey_tap.cpp
@@ -0,0 +1,233 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+MATCHER_P2(ExtraReport, report_id, usage, "") {
+    return arg.report_id == report_id && arg.usage == usage;
+}
+
+#define EXPECT_CONSUMER(driver, usage) EXPECT_CALL((driver), send_extra_mock(ExtraReport(REPORT_ID_CONSUMER, (usage))))
+#define EXPECT_SYSTEM(driver, usage) EXPECT_CALL((driver), send_extra_mock(ExtraReport(REPORT_ID_SYSTEM, (usage))))
+
+class ExtrakeyTap : public TestFixture {
+   protected:
+    // the timer restarts with every test, wait out the last tap report of the previous ones
+    void start_from_a_finished_interval() {
+        idle_for(500);
+    }
+};
+
+TEST_F(ExtrakeyTap, TapsDoNotWait) {
+    TestDriver driver;
+
+    start_from_a_finished_interval();
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(0);
+    uint32_t start = timer_read32();
+    tap_code(KC_VOLU);
+    tap_code(KC_VOLU);
+    EXPECT_EQ(timer_read32(), start);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(4);
+    idle_for(USB_POLLING_INTERVAL_MS * 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExtrakeyTap, TapsArePacedByThePollInterval) {
+    TestDriver driver;
+
+    start_from_a_finished_interval();
+
+    tap_code(KC_VOLU);
+    tap_code(KC_VOLU);
+    tap_code(KC_VOLU);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_CONSUMER(driver, AUDIO_VOL_UP);
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+
+        EXPECT_CALL(driver, send_extra_mock(_)).Times(0);
+        idle_for(USB_POLLING_INTERVAL_MS - 1);
+        VERIFY_AND_CLEAR(driver);
+
+        EXPECT_CONSUMER(driver, 0);
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+
+        idle_for(USB_POLLING_INTERVAL_MS - 1);
+    }
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(0);
+    idle_for(USB_POLLING_INTERVAL_MS * 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExtrakeyTap, TapsKeepTheirOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    tap_code(KC_VOLU);
+    tap_code(KC_VOLU);
+    tap_code(KC_VOLD);
+    tap_code(KC_VOLU);
+
+    EXPECT_CONSUMER(driver, AUDIO_VOL_UP);
+    EXPECT_CONSUMER(driver, 0);
+    EXPECT_CONSUMER(driver, AUDIO_VOL_UP);
+    EXPECT_CONSUMER(driver, 0);
+    EXPECT_CONSUMER(driver, AUDIO_VOL_DOWN);
+    EXPECT_CONSUMER(driver, 0);
+    EXPECT_CONSUMER(driver, AUDIO_VOL_UP);
+    EXPECT_CONSUMER(driver, 0);
+    idle_for(USB_POLLING_INTERVAL_MS * 10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExtrakeyTap, TapWithDelayIsNotQueued) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CONSUMER(driver, AUDIO_VOL_UP);
+    EXPECT_CONSUMER(driver, 0);
+    uint32_t start = timer_read32();
+    tap_code_delay(KC_VOLU, 30);
+    EXPECT_EQ(timer_elapsed32(start), 30);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(0);
+    idle_for(USB_POLLING_INTERVAL_MS * 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExtrakeyTap, FullQueueWaitsForRoom) {
+    TestDriver driver;
+    InSequence s;
+
+    // four entries, alternating usages are not counted together
+    tap_code(KC_VOLU);
+    tap_code(KC_VOLD);
+    tap_code(KC_VOLU);
+    tap_code(KC_VOLD);
+
+    // the first entry is sent to make room
+    EXPECT_CONSUMER(driver, AUDIO_VOL_UP);
+    EXPECT_CONSUMER(driver, 0);
+    tap_code(KC_MUTE);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CONSUMER(driver, AUDIO_VOL_DOWN);
+    EXPECT_CONSUMER(driver, 0);
+    EXPECT_CONSUMER(driver, AUDIO_VOL_UP);
+    EXPECT_CONSUMER(driver, 0);
+    EXPECT_CONSUMER(driver, AUDIO_VOL_DOWN);
+    EXPECT_CONSUMER(driver, 0);
+    EXPECT_CONSUMER(driver, AUDIO_MUTE);
+    EXPECT_CONSUMER(driver, 0);
+    idle_for(USB_POLLING_INTERVAL_MS * 10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExtrakeyTap, KeyboardTapsAreSentAfterQueuedTaps) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_CONSUMER(driver, AUDIO_MUTE);
+    EXPECT_CONSUMER(driver, 0);
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_code(KC_MUTE);
+    tap_code(KC_ENTER);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CONSUMER(driver, AUDIO_VOL_UP);
+    EXPECT_CONSUMER(driver, 0);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_code(KC_VOLU);
+    tap_code(KC_A);
+    tap_code(KC_VOLD);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CONSUMER(driver, AUDIO_VOL_DOWN);
+    EXPECT_CONSUMER(driver, 0);
+    idle_for(USB_POLLING_INTERVAL_MS * 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExtrakeyTap, RegisteredKeyDropsQueuedTapsOfItsReport) {
+    TestDriver driver;
+    InSequence s;
+
+    tap_code(KC_PWR);
+    tap_code(KC_VOLU);
+    tap_code(KC_VOLU);
+
+    EXPECT_CONSUMER(driver, AUDIO_MUTE);
+    register_code(KC_MUTE);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_SYSTEM(driver, SYSTEM_POWER_DOWN);
+    EXPECT_SYSTEM(driver, 0);
+    idle_for(USB_POLLING_INTERVAL_MS * 8);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CONSUMER(driver, 0);
+    unregister_code(KC_MUTE);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExtrakeyTap, RegisteredKeyReplacesAPressedTap) {
+    TestDriver driver;
+    InSequence s;
+
+    start_from_a_finished_interval();
+
+    tap_code(KC_VOLU);
+    tap_code(KC_VOLU);
+
+    EXPECT_CONSUMER(driver, AUDIO_VOL_UP);
+    run_one_scan_loop();
+    EXPECT_CONSUMER(driver, AUDIO_MUTE);
+    register_code(KC_MUTE);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(0);
+    idle_for(USB_POLLING_INTERVAL_MS * 4);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CONSUMER(driver, 0);
+    unregister_code(KC_MUTE);
+    idle_for(USB_POLLING_INTERVAL_MS * 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ExtrakeyTap, KeysAreReportedWhileTapsDrain) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    for (int i = 0; i < 8; i++) {
+        tap_code(KC_VOLU);
+    }
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(1);
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(15);
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    idle_for(USB_POLLING_INTERVAL_MS * 16);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,171 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+static int  scans   = 0;
+static int  sleeps  = 0;
+static int  parks   = 0;
+static int  unparks = 0;
+static int  hooks   = 0;
+static bool glitch  = false;
+
+extern "C" {
+void last_matrix_activity_trigger(void);
+
+bool matrix_can_read(void) {
+    scans++;
+    return true;
+}
+
+bool matrix_park(void) {
+    parks++;
+    return true;
+}
+
+bool matrix_parked_pressed(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (matrix_is_on(row, col)) {
+                return true;
+            }
+        }
+    }
+    return glitch;
+}
+
+void matrix_unpark(void) {
+    unparks++;
+}
+
+void matrix_scan_kb(void) {
+    hooks++;
+}
+
+void keyboard_idle_sleep(void) {
+    sleeps++;
+}
+}
+
+class KeyboardIdle : public TestFixture {
+   protected:
+    // Leaves idle mode from the previous test, the next scan loop reaches the timeout
+    void reset_idle() {
+        last_matrix_activity_trigger();
+        run_one_scan_loop();
+        idle_for(KEYBOARD_IDLE_TIMEOUT - 1);
+        scans = sleeps = parks = unparks = hooks = 0;
+        glitch                                   = false;
+    }
+};
+
+TEST_F(KeyboardIdle, ParksAfterTimeout) {
+    TestDriver driver;
+
+    reset_idle();
+    EXPECT_NO_REPORT(driver);
+    idle_for(100);
+    EXPECT_EQ(parks, 1);
+    EXPECT_EQ(unparks, 0);
+    EXPECT_EQ(scans, 0);
+    EXPECT_EQ(sleeps, 100);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardIdle, ScanHooksRunWhileParked) {
+    TestDriver driver;
+
+    reset_idle();
+    EXPECT_NO_REPORT(driver);
+    idle_for(100);
+    ASSERT_EQ(parks, 1);
+    EXPECT_EQ(scans, 0);
+    EXPECT_EQ(hooks, 100);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardIdle, KeyDownWakesAndReports) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    reset_idle();
+
+    idle_for(100);
+    ASSERT_EQ(parks, 1);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(unparks, 1);
+    EXPECT_EQ(scans, 1);
+
+    // scanning at full rate again, no sleeping while a key is down
+    sleeps = 0;
+    idle_for(KEYBOARD_IDLE_TIMEOUT * 2);
+    EXPECT_EQ(sleeps, 0);
+    EXPECT_EQ(parks, 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardIdle, ActivityTimeIsTheWake) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    reset_idle();
+
+    idle_for(100);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    uint32_t wake = timer_read32();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(last_matrix_activity_time(), wake);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardIdle, GlitchDoesNotHoldTheActivityTime) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    reset_idle();
+
+    idle_for(100);
+
+    // an edge that never turns into a key press
+    glitch = true;
+    run_one_scan_loop();
+    glitch = false;
+    EXPECT_EQ(unparks, 1);
+
+    idle_for(KEYBOARD_IDLE_TIMEOUT / 2);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    uint32_t pressed = timer_read32();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(last_matrix_activity_time(), pressed);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,6 @@
+// Copyright 2023 LeleLab
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
@@ -0,0 +1,8 @@
+# Copyright 2023 LeleLab
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+LELE76_KEYMAP_PATH = keyboards/lelelab/lele76/keymaps/default
+
+SRC += \
+	$(LELE76_KEYMAP_PATH)/sin.c \
+	$(LELE76_KEYMAP_PATH)/rot3d.c
@@ -0,0 +1,106 @@
+// Copyright 2023 LeleLab
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cmath>
+#include <cstdlib>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "keyboards/lelelab/lele76/keymaps/default/sin.h"
+#include "keyboards/lelelab/lele76/keymaps/default/rot3d.h"
+}
+
+#define CUBE_NODES 8
+#define CUBE_SIZE 10
+
+static const int8_t unit_cube[CUBE_NODES][3] = {{-1, -1, -1}, {-1, -1, 1}, {-1, 1, -1}, {-1, 1, 1}, {1, -1, -1}, {1, -1, 1}, {1, 1, -1}, {1, 1, 1}};
+
+// Reference: the previous soft-float implementation of RotateCube()
+static void rotate_float(const int8_t src[][3], int8_t dst[][3], uint8_t count, uint16_t ax, uint16_t ay, uint16_t az) {
+    const float sx = sinf(ax * M_PI / 180), cx = cosf(ax * M_PI / 180);
+    const float sy = sinf(ay * M_PI / 180), cy = cosf(ay * M_PI / 180);
+    const float sz = sinf(az * M_PI / 180), cz = cosf(az * M_PI / 180);
+
+    for (uint8_t i = 0; i < count; i++) {
+        float rotz = src[i][ZCOORD] * cy - src[i][XCOORD] * sy;
+        float rotx = src[i][ZCOORD] * sy + src[i][XCOORD] * cy;
+        float roty = src[i][YCOORD];
+
+        float rotyy = roty * cx - rotz * sx;
+        float rotzz = roty * sx + rotz * cx;
+
+        dst[i][XCOORD] = rotx * cz - rotyy * sz;
+        dst[i][YCOORD] = rotx * sz + rotyy * cz;
+        dst[i][ZCOORD] = rotzz;
+    }
+}
+
+class Rot3D : public ::testing::Test {
+   protected:
+    int8_t nodes[CUBE_NODES][3];
+
+    void SetUp() override {
+        for (int n = 0; n < CUBE_NODES; n++) {
+            for (int c = 0; c < 3; c++) {
+                nodes[n][c] = unit_cube[n][c] * CUBE_SIZE;
+            }
+        }
+    }
+};
+
+TEST_F(Rot3D, SinCosMatchFloat) {
+    for (uint16_t angle = 0; angle <= 360; angle++) {
+        EXPECT_NEAR(SIN(angle) / (float)TRIG_Q15_ONE, sinf(angle * M_PI / 180), 1.0f / 16384) << "angle " << angle;
+        EXPECT_NEAR(COS(angle) / (float)TRIG_Q15_ONE, cosf(angle * M_PI / 180), 1.0f / 16384) << "angle " << angle;
+    }
+}
+
+TEST_F(Rot3D, RotationWithinOnePixelOfFloat) {
+    int8_t fixed[CUBE_NODES][3];
+    int8_t ref[CUBE_NODES][3];
+
+    for (uint16_t ax = 0; ax < 360; ax += 4) {
+        for (uint16_t ay = 0; ay < 360; ay += 3) {
+            for (uint16_t az = 0; az < 360; az += 7) {
+                Rotate3D(nodes, fixed, CUBE_NODES, ax, ay, az);
+                rotate_float(nodes, ref, CUBE_NODES, ax, ay, az);
+                for (int n = 0; n < CUBE_NODES; n++) {
+                    for (int c = 0; c < 3; c++) {
+                        ASSERT_LE(abs(fixed[n][c] - ref[n][c]), 1) << "angles " << ax << "," << ay << "," << az << " node " << n << " coord " << c;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(Rot3D, LargeCubeDoesNotOverflow) {
+    int8_t fixed[CUBE_NODES][3];
+    int8_t ref[CUBE_NODES][3];
+
+    for (int n = 0; n < CUBE_NODES; n++) {
+        for (int c = 0; c < 3; c++) {
+            nodes[n][c] = unit_cube[n][c] * 70;
+        }
+    }
+
+    for (uint16_t angle = 0; angle < 360; angle++) {
+        Rotate3D(nodes, fixed, CUBE_NODES, angle, 359 - angle, (angle * 3) % 360);
+        rotate_float(nodes, ref, CUBE_NODES, angle, 359 - angle, (angle * 3) % 360);
+        for (int n = 0; n < CUBE_NODES; n++) {
+            for (int c = 0; c < 3; c++) {
+                ASSERT_LE(abs(fixed[n][c] - ref[n][c]), 1) << "angle " << angle << " node " << n << " coord " << c;
+            }
+        }
+    }
+}
+
+TEST_F(Rot3D, ProjectionOffsetsNodes) {
+    uint8_t projected[CUBE_NODES][2];
+
+    Project3D(nodes, projected, CUBE_NODES, 96, 32);
+    for (int n = 0; n < CUBE_NODES; n++) {
+        EXPECT_EQ(projected[n][0], 96 + nodes[n][XCOORD]);
+        EXPECT_EQ(projected[n][1], 32 + nodes[n][YCOORD]);
+    }
+}
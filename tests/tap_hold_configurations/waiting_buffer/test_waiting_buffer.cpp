@@ -0,0 +1,201 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+// Letters as they go down in the reports, upper case while shift is held
+class TypedText {
+   public:
+    explicit TypedText(TestDriver& driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly([this](report_keyboard_t& report) {
+            add(report);
+        });
+    }
+
+    std::string text;
+    uint8_t     mods      = 0;
+    uint8_t     mods_seen = 0;
+    bool        keys      = false;
+
+   private:
+    report_keyboard_t last = {};
+
+    void add(const report_keyboard_t& report) {
+        keys = false;
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            uint8_t key = report.keys[i];
+            if (key == 0) {
+                continue;
+            }
+            keys = true;
+            if (std::find(std::begin(last.keys), std::end(last.keys), key) == std::end(last.keys)) {
+                char letter = 'a' + (key - KC_A);
+                text += (report.mods & MOD_MASK_SHIFT) ? letter - 'a' + 'A' : letter;
+            }
+        }
+        mods = report.mods;
+        mods_seen |= report.mods;
+        last = report;
+    }
+};
+
+class WaitingBuffer : public TestFixture {
+   protected:
+    std::mt19937 rng{0x7A991E};
+
+    // Home row mod-taps and plain letters
+    std::vector<KeymapKey> keys = {
+        KeymapKey(0, 0, 0, LSFT_T(KC_A)), KeymapKey(0, 1, 0, LCTL_T(KC_S)), KeymapKey(0, 2, 0, LALT_T(KC_D)), KeymapKey(0, 3, 0, LGUI_T(KC_F)),
+        KeymapKey(0, 0, 1, KC_Q),         KeymapKey(0, 1, 1, KC_W),         KeymapKey(0, 2, 1, KC_E),         KeymapKey(0, 3, 1, KC_R),
+        KeymapKey(0, 4, 1, KC_T),         KeymapKey(0, 5, 1, KC_Y),         KeymapKey(0, 6, 1, KC_U),         KeymapKey(0, 7, 1, KC_I),
+        KeymapKey(0, 8, 1, KC_O),         KeymapKey(0, 9, 1, KC_P),         KeymapKey(0, 0, 2, KC_G),         KeymapKey(0, 1, 2, KC_H),
+        KeymapKey(0, 2, 2, KC_J),         KeymapKey(0, 3, 2, KC_K),         KeymapKey(0, 4, 2, KC_L),
+    };
+
+    static constexpr size_t mod_taps = 4;
+
+    WaitingBuffer() {
+        for (auto& key : keys) {
+            add_key(key);
+        }
+    }
+
+    static char letter(const KeymapKey& key) {
+        return 'a' + (QK_MOD_TAP_GET_TAP_KEYCODE(key.code) - KC_A);
+    }
+
+    struct Event {
+        uint32_t time;
+        size_t   key;
+        bool     pressed;
+    };
+
+    /* Rolls over `count` random keys, a new key goes down every `interval` ms while the
+     * last ones are held for `hold` ms, mod-taps for `mod_tap_hold` ms. Returns the
+     * letters in the order they went down.
+     */
+    std::string roll(size_t count, std::uniform_int_distribution<uint32_t> interval, std::uniform_int_distribution<uint32_t> hold, std::uniform_int_distribution<uint32_t> mod_tap_hold) {
+        std::vector<Event>    events;
+        std::vector<uint32_t> released(keys.size(), 0);
+        std::string           text;
+        uint32_t              time = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            size_t key;
+            do {
+                key = rng() % keys.size();
+            } while (released[key] > time);
+
+            uint32_t up   = time + (key < mod_taps ? mod_tap_hold(rng) : hold(rng));
+            released[key] = up + 1;
+            events.push_back({time, key, true});
+            events.push_back({up, key, false});
+            text += letter(keys[key]);
+            time += interval(rng);
+        }
+        std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+            return a.time < b.time;
+        });
+
+        uint32_t start = timer_read32();
+        for (auto& event : events) {
+            uint32_t due = start + event.time;
+            if (timer_read32() < due) {
+                idle_for(due - timer_read32());
+            }
+            if (event.pressed) {
+                keys[event.key].press();
+            } else {
+                keys[event.key].release();
+            }
+            run_one_scan_loop();
+        }
+        idle_for(TAPPING_TERM * 2);
+        return text;
+    }
+
+    std::string plain_letters(const std::string& text) {
+        std::string result;
+        for (char c : text) {
+            if (c != 'a' && c != 's' && c != 'd' && c != 'f' && c != 'A' && c != 'S' && c != 'D' && c != 'F') {
+                result += tolower(c);
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F(WaitingBuffer, RollsAt200WpmTypeEveryLetterInOrder) {
+    TestDriver driver;
+    TypedText  typed(driver);
+
+    // 30-60ms between key downs is 200-400 words per minute, every key overlaps the next
+    std::string text = roll(2000, std::uniform_int_distribution<uint32_t>(30, 60), std::uniform_int_distribution<uint32_t>(60, 140), std::uniform_int_distribution<uint32_t>(60, 140));
+
+    EXPECT_EQ(typed.text, text);
+    EXPECT_EQ(typed.mods_seen, 0);
+    EXPECT_FALSE(typed.keys);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(WaitingBuffer, OverloadedRollsDropNothing) {
+    TestDriver driver;
+    TypedText  typed(driver);
+
+    // mod-taps held close to their tapping term behind 400-800 words per minute fill the buffer
+    std::string text = roll(2000, std::uniform_int_distribution<uint32_t>(15, 30), std::uniform_int_distribution<uint32_t>(30, 50), std::uniform_int_distribution<uint32_t>(TAPPING_TERM - 50, TAPPING_TERM - 10));
+
+    // a mod-tap decided as held types no letter, every other letter gets through in order
+    EXPECT_NE(typed.mods_seen, 0);
+    EXPECT_EQ(plain_letters(typed.text), plain_letters(text));
+    EXPECT_EQ(typed.mods, 0);
+    EXPECT_FALSE(typed.keys);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(WaitingBuffer, OverflowDecidesTappingKeyAsHeld) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 0, 3, SFT_T(KC_P));
+    auto       regular_key = KeymapKey(0, 1, 3, KC_A);
+
+    set_keymap({mod_tap_key, regular_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    for (int i = 0; i < (WAITING_BUFFER_SIZE - 2) / 2; i++) {
+        tap_key(regular_key);
+    }
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The event that does not fit decides the mod-tap, everything waiting follows. */
+    EXPECT_REPORT(driver, (KC_LSFT));
+    for (int i = 0; i < (WAITING_BUFFER_SIZE - 2) / 2; i++) {
+        EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+        EXPECT_REPORT(driver, (KC_LSFT));
+    }
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
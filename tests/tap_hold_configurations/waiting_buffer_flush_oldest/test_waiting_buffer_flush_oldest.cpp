@@ -0,0 +1,51 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class WaitingBufferFlushOldest : public TestFixture {};
+
+TEST_F(WaitingBufferFlushOldest, OverflowSendsOldestEventAhead) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({mod_tap_key, regular_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    for (int i = 0; i < (WAITING_BUFFER_SIZE - 2) / 2; i++) {
+        tap_key(regular_key);
+    }
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The event that does not fit pushes the oldest one out, the mod-tap stays undecided. */
+    EXPECT_REPORT(driver, (KC_A));
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Released within the tapping term it is still a tap, everything waiting follows. */
+    EXPECT_REPORT(driver, (KC_A, KC_P));
+    EXPECT_REPORT(driver, (KC_P));
+    for (int i = 0; i < (WAITING_BUFFER_SIZE - 2) / 2; i++) {
+        EXPECT_REPORT(driver, (KC_A, KC_P));
+        EXPECT_REPORT(driver, (KC_P));
+    }
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,143 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "task_profiler.h"
+
+void advance_time(uint32_t ms);
+
+static uint32_t slow_key_ms = 0;
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    advance_time(slow_key_ms);
+    return true;
+}
+}
+
+using testing::_;
+
+class TaskProfiler : public TestFixture {
+   protected:
+    void SetUp() override {
+        slow_key_ms = 0;
+        task_profiler_reset();
+    }
+
+    // Records a sample of the given length in timestamp ticks, a millisecond each in tests
+    static void record(task_profiler_task_t task, uint32_t ticks) {
+        task_profiler_record(task, task_profiler_timestamp() - ticks);
+    }
+};
+
+TEST_F(TaskProfiler, EveryPassIsRecorded) {
+    TestDriver            driver;
+    task_profiler_stats_t stats;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_FALSE(task_profiler_get(TASK_PROFILER_KEYBOARD, &stats));
+    for (int i = 0; i < 10; i++) {
+        run_one_scan_loop();
+    }
+
+    for (task_profiler_task_t task : {TASK_PROFILER_KEYBOARD, TASK_PROFILER_MATRIX, TASK_PROFILER_QUANTUM, TASK_PROFILER_LED}) {
+        ASSERT_TRUE(task_profiler_get(task, &stats));
+        EXPECT_EQ(stats.count, 10);
+        EXPECT_EQ(stats.max, 0);
+    }
+    // run by the main loop, not keyboard_task()
+    EXPECT_FALSE(task_profiler_get(TASK_PROFILER_LOOP, &stats));
+    EXPECT_FALSE(task_profiler_get(TASK_PROFILER_HOUSEKEEPING, &stats));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TaskProfiler, SlowTaskIsCharged) {
+    TestDriver            driver;
+    auto                  key = KeymapKey(0, 0, 0, KC_A);
+    task_profiler_stats_t stats;
+
+    set_keymap({key});
+    slow_key_ms = 3;
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_MATRIX, &stats));
+    EXPECT_EQ(stats.max, 3000);
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_KEYBOARD, &stats));
+    EXPECT_EQ(stats.max, 3000);
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_QUANTUM, &stats));
+    EXPECT_EQ(stats.max, 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TaskProfiler, MinAvgMax) {
+    task_profiler_stats_t stats;
+
+    record(TASK_PROFILER_LED, 2);
+    record(TASK_PROFILER_LED, 4);
+    record(TASK_PROFILER_LED, 9);
+
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_LED, &stats));
+    EXPECT_EQ(stats.count, 3);
+    EXPECT_EQ(stats.min, 2000);
+    EXPECT_EQ(stats.avg, 5000);
+    EXPECT_EQ(stats.max, 9000);
+    EXPECT_EQ(stats.p99, 9000);
+}
+
+TEST_F(TaskProfiler, P99IgnoresRareOutliers) {
+    task_profiler_stats_t stats;
+
+    for (int i = 0; i < 995; i++) {
+        record(TASK_PROFILER_LOOP, 1);
+    }
+    for (int i = 0; i < 5; i++) {
+        record(TASK_PROFILER_LOOP, 100);
+    }
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_LOOP, &stats));
+    EXPECT_EQ(stats.p99, 1000);
+    EXPECT_EQ(stats.max, 100000);
+
+    for (int i = 0; i < 20; i++) {
+        record(TASK_PROFILER_LOOP, 100);
+    }
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_LOOP, &stats));
+    // rounded up to the top of the power of two range, never above the max
+    EXPECT_EQ(stats.p99, 100000);
+}
+
+TEST_F(TaskProfiler, WindowDecaysAndFollowsChange) {
+    task_profiler_stats_t stats;
+
+    for (int i = 0; i < 100000; i++) {
+        record(TASK_PROFILER_HOUSEKEEPING, 1);
+    }
+    for (int i = 0; i < 1000000; i++) {
+        record(TASK_PROFILER_HOUSEKEEPING, 8);
+    }
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_HOUSEKEEPING, &stats));
+    EXPECT_GT(stats.count, UINT16_MAX / 2);
+    EXPECT_EQ(stats.min, 1000);
+    EXPECT_GT(stats.avg, 7000);
+    EXPECT_EQ(stats.p99, 8000);
+}
+
+TEST_F(TaskProfiler, PrintClears) {
+    task_profiler_stats_t stats;
+
+    record(TASK_PROFILER_LED, 1);
+    task_profiler_print();
+    EXPECT_FALSE(task_profiler_get(TASK_PROFILER_LED, &stats));
+    EXPECT_EQ(stats.count, 0);
+}
@@ -0,0 +1,10 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// reports are only printed on request
+#define TASK_PROFILER_INTERVAL 0
+#define TASK_PROFILER_LATENCY
@@ -0,0 +1,146 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "task_profiler.h"
+}
+
+using testing::_;
+
+class TaskProfilerLatency : public TestFixture {
+   protected:
+    void SetUp() override {
+        task_profiler_reset();
+    }
+};
+
+TEST_F(TaskProfilerLatency, PlainKeyIsReportedInItsScan) {
+    TestDriver            driver;
+    task_profiler_stats_t stats;
+    auto                  key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key, 20);
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_PROCESS_DELAY, &stats));
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.max, 0);
+}
+
+TEST_F(TaskProfilerLatency, TappingDelayIsCharged) {
+    TestDriver            driver;
+    task_profiler_stats_t stats;
+    auto                  key = KeymapKey(0, 0, 0, LSFT_T(KC_A));
+
+    set_keymap({key});
+
+    // the tap is only known, and reported, when the key goes up
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    key.press();
+    idle_for(50);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_PROCESS_DELAY, &stats));
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.max, 50 * 1000);
+}
+
+TEST_F(TaskProfilerLatency, DebounceDelayRunsFromTheRawChange) {
+    TestDriver            driver;
+    task_profiler_stats_t stats;
+    auto                  key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    task_profiler_raw_changed();
+    idle_for(5);
+    EXPECT_FALSE(task_profiler_get(TASK_PROFILER_DEBOUNCE_DELAY, &stats));
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_DEBOUNCE_DELAY, &stats));
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.max, 5 * 1000);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TaskProfilerLatency, UsbDelayRunsUntilTheReportIsSent) {
+    TestDriver            driver;
+    task_profiler_stats_t stats;
+    auto                  key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // the test driver has no endpoint, the protocol would report it written
+    idle_for(3);
+    task_profiler_report_sent();
+    task_profiler_report_sent();
+
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_USB_DELAY, &stats));
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.max, 4 * 1000);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TaskProfilerLatency, BufferedUsbDelayWaitsForItsReport) {
+    TestDriver            driver;
+    task_profiler_stats_t stats;
+    auto                  key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    // a report queued before the key is still in the protocol's buffer
+    task_profiler_report_sent();
+    task_profiler_reset();
+    uint8_t older = task_profiler_report_seq();
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    idle_for(3);
+    task_profiler_report_sent_seq(older);
+    EXPECT_FALSE(task_profiler_get(TASK_PROFILER_USB_DELAY, &stats));
+
+    // the release is merged into the slot of the press, which is written later
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    idle_for(3);
+    task_profiler_report_sent_seq(task_profiler_report_seq());
+
+    ASSERT_TRUE(task_profiler_get(TASK_PROFILER_USB_DELAY, &stats));
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.max, 8 * 1000);
+}
@@ -38,7 +38,7 @@ void matrix_print(void) {}
 
 void matrix_init_kb(void) {}
 
-void matrix_scan_kb(void) {}
+__attribute__((weak)) void matrix_scan_kb(void) {}
 
 void press_key(uint8_t col, uint8_t row) {
     matrix[row] |= (matrix_row_t)1 << col;
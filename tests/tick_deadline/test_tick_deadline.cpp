@@ -0,0 +1,167 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "action_util.h"
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+class TickDeadline : public TestFixture {
+   protected:
+    uint32_t skipped_from = 0;
+
+    void count_skipped() {
+        skipped_from = get_tick_events_skipped();
+    }
+
+    uint32_t skipped() {
+        return get_tick_events_skipped() - skipped_from;
+    }
+};
+
+TEST_F(TickDeadline, NothingPendingSkipsEveryTick) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    count_skipped();
+    idle_for(100);
+    EXPECT_EQ(skipped(), 100);
+    EXPECT_FALSE(action_deadline_pending());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TickDeadline, ModTapHoldIsDecidedOnTime) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(action_deadline_pending());
+    count_skipped();
+    idle_for(TAPPING_TERM - 1);
+    EXPECT_EQ(skipped(), TAPPING_TERM - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    // the tick at the tapping term is the same one that decided it every millisecond
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(action_deadline_pending());
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TickDeadline, TapResetsAfterTappingTerm) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({mod_tap_key, regular_key});
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(mod_tap_key);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(action_deadline_pending());
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(action_deadline_pending());
+
+    count_skipped();
+    idle_for(50);
+    EXPECT_EQ(skipped(), 50);
+
+    // a new press starts a new tap, not a sequential one
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(mod_tap_key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TickDeadline, HoldAfterTapNeedsNoTicks) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(mod_tap_key);
+    VERIFY_AND_CLEAR(driver);
+
+    // a quick second press repeats the tap and holds it
+    EXPECT_REPORT(driver, (KC_P));
+    mod_tap_key.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(action_deadline_pending());
+
+    count_skipped();
+    idle_for(50);
+    EXPECT_EQ(skipped(), 50);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TickDeadline, OneShotModTimesOutOnTime) {
+    TestDriver driver;
+    auto       osm_key     = KeymapKey(0, 0, 0, OSM(MOD_LSFT));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({osm_key, regular_key});
+
+    EXPECT_NO_REPORT(driver);
+    osm_key.press();
+    run_one_scan_loop();
+    osm_key.release();
+    run_one_scan_loop();
+    EXPECT_TRUE(action_deadline_pending());
+
+    // one tick ends the tap of the one shot key at the tapping term
+    count_skipped();
+    idle_for(ONESHOT_TIMEOUT - 10);
+    EXPECT_EQ(skipped(), ONESHOT_TIMEOUT - 10 - 1);
+    EXPECT_EQ(get_oneshot_mods(), MOD_BIT(KC_LSFT));
+    idle_for(10);
+    EXPECT_EQ(get_oneshot_mods(), 0);
+    EXPECT_FALSE(action_deadline_pending());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TickDeadline, OneShotModSetOutsideOfAKeyTimesOut) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    set_oneshot_mods(MOD_BIT(KC_LCTL));
+    EXPECT_TRUE(action_deadline_pending());
+    idle_for(ONESHOT_TIMEOUT + 1);
+    EXPECT_EQ(get_oneshot_mods(), 0);
+    EXPECT_FALSE(action_deadline_pending());
+    VERIFY_AND_CLEAR(driver);
+}
@@ -43,6 +43,7 @@
 #include "usb_device_state.h"
 #include "usb_descriptor.h"
 #include "usb_driver.h"
+#include "task_profiler.h"
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -899,6 +900,7 @@ void send_keyboard(report_keyboard_t *report) {
 
         send_report(ep, report, size);
     }
+    task_profiler_report_sent();
 
     keyboard_report_sent = *report;
 }
@@ -21,6 +21,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "timer.h"
+#include "task_profiler.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -44,6 +46,35 @@ static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 
+#if defined(EXTRAKEY_ENABLE) && defined(EXTRA_TAP_QUEUE_ENABLE)
+#    ifndef EXTRA_TAP_QUEUE_SIZE
+#        define EXTRA_TAP_QUEUE_SIZE 4
+#    endif
+// one report per poll of the endpoint, a press and its release take two
+#    ifndef EXTRA_TAP_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define EXTRA_TAP_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define EXTRA_TAP_INTERVAL 1
+#        endif
+#    endif
+
+// taps of the same usage in a row are counted in one entry
+typedef struct {
+    uint8_t  report_id;
+    uint8_t  count;
+    uint16_t usage;
+} extra_tap_t;
+
+static extra_tap_t extra_taps[EXTRA_TAP_QUEUE_SIZE];
+static uint8_t     extra_tap_head    = 0;
+static uint8_t     extra_tap_len     = 0;
+static bool        extra_tap_pressed = false;
+static uint16_t    extra_tap_time    = 0;
+
+static void extra_tap_drop(uint8_t report_id);
+#endif
+
 void host_set_driver(host_driver_t *d) {
     driver = d;
 }
@@ -95,6 +126,7 @@ void host_keyboard_send(report_keyboard_t *report) {
         report->report_id = REPORT_ID_KEYBOARD;
 #endif
     }
+    task_profiler_report_queued();
     (*driver->send_keyboard)(report);
 
     if (debug_keyboard) {
@@ -126,7 +158,7 @@ void host_mouse_send(report_mouse_t *report) {
     (*driver->send_mouse)(report);
 }
 
-void host_system_send(uint16_t usage) {
+static void send_system_usage(uint16_t usage) {
     if (usage == last_system_usage) return;
     last_system_usage = usage;
 
@@ -139,7 +171,7 @@ void host_system_send(uint16_t usage) {
     (*driver->send_extra)(&report);
 }
 
-void host_consumer_send(uint16_t usage) {
+static void send_consumer_usage(uint16_t usage) {
     if (usage == last_consumer_usage) return;
     last_consumer_usage = usage;
 
@@ -159,6 +191,24 @@ void host_consumer_send(uint16_t usage) {
     (*driver->send_extra)(&report);
 }
 
+void host_system_send(uint16_t usage) {
+#if defined(EXTRAKEY_ENABLE) && defined(EXTRA_TAP_QUEUE_ENABLE)
+    if (usage) {
+        extra_tap_drop(REPORT_ID_SYSTEM);
+    }
+#endif
+    send_system_usage(usage);
+}
+
+void host_consumer_send(uint16_t usage) {
+#if defined(EXTRAKEY_ENABLE) && defined(EXTRA_TAP_QUEUE_ENABLE)
+    if (usage) {
+        extra_tap_drop(REPORT_ID_CONSUMER);
+    }
+#endif
+    send_consumer_usage(usage);
+}
+
 #ifdef JOYSTICK_ENABLE
 void host_joystick_send(joystick_t *joystick) {
     if (!driver) return;
@@ -246,6 +296,83 @@ void host_programmable_button_send(uint32_t data) {
 
 __attribute__((weak)) void send_programmable_button(report_programmable_button_t *report) {}
 
+#if defined(EXTRAKEY_ENABLE) && defined(EXTRA_TAP_QUEUE_ENABLE)
+static bool host_extra_tap(uint8_t report_id, uint16_t usage) {
+    if (extra_tap_len) {
+        extra_tap_t *last = &extra_taps[(extra_tap_head + extra_tap_len - 1) % EXTRA_TAP_QUEUE_SIZE];
+        if (last->report_id == report_id && last->usage == usage && last->count < UINT8_MAX) {
+            last->count++;
+            return true;
+        }
+    }
+    if (extra_tap_len == EXTRA_TAP_QUEUE_SIZE) {
+        return false;
+    }
+
+    extra_taps[(extra_tap_head + extra_tap_len) % EXTRA_TAP_QUEUE_SIZE] = (extra_tap_t){
+        .report_id = report_id,
+        .count     = 1,
+        .usage     = usage,
+    };
+    extra_tap_len++;
+    return true;
+}
+
+bool host_system_tap(uint16_t usage) {
+    return host_extra_tap(REPORT_ID_SYSTEM, usage);
+}
+
+bool host_consumer_tap(uint16_t usage) {
+    return host_extra_tap(REPORT_ID_CONSUMER, usage);
+}
+
+/* A key registered through host_*_send() is sent right away and replaces the queued
+ * taps of its report, including one pressed already. */
+static void extra_tap_drop(uint8_t report_id) {
+    uint8_t len = 0;
+    for (uint8_t i = 0; i < extra_tap_len; i++) {
+        extra_tap_t tap = extra_taps[(extra_tap_head + i) % EXTRA_TAP_QUEUE_SIZE];
+        if (tap.report_id == report_id) {
+            if (i == 0) {
+                extra_tap_pressed = false;
+            }
+            continue;
+        }
+        extra_taps[(extra_tap_head + len++) % EXTRA_TAP_QUEUE_SIZE] = tap;
+    }
+    extra_tap_len = len;
+}
+
+void host_extra_task(void) {
+    if (!extra_tap_len || timer_elapsed(extra_tap_time) < EXTRA_TAP_INTERVAL) {
+        return;
+    }
+    extra_tap_time = timer_read();
+
+    extra_tap_t *tap   = &extra_taps[extra_tap_head];
+    uint16_t     usage = extra_tap_pressed ? 0 : tap->usage;
+    if (tap->report_id == REPORT_ID_SYSTEM) {
+        send_system_usage(usage);
+    } else {
+        send_consumer_usage(usage);
+    }
+
+    extra_tap_pressed = !extra_tap_pressed;
+    if (!extra_tap_pressed && --tap->count == 0) {
+        extra_tap_head = (extra_tap_head + 1) % EXTRA_TAP_QUEUE_SIZE;
+        extra_tap_len--;
+    }
+}
+#endif
+
+bool host_extra_tap_pending(void) {
+#if defined(EXTRAKEY_ENABLE) && defined(EXTRA_TAP_QUEUE_ENABLE)
+    return extra_tap_len;
+#else
+    return false;
+#endif
+}
+
 uint16_t host_last_system_usage(void) {
     return last_system_usage;
 }
@@ -49,6 +49,14 @@ void    host_programmable_button_send(uint32_t data);
 uint16_t host_last_system_usage(void);
 uint16_t host_last_consumer_usage(void);
 
+/* system and consumer taps with EXTRA_TAP_QUEUE_ENABLE, sent as a press and a release one poll interval
+ * apart by host_extra_task(). the tap_*() functions return false when the queue is full. A key registered
+ * through host_*_send() drops the queued taps of its report */
+bool host_system_tap(uint16_t usage);
+bool host_consumer_tap(uint16_t usage);
+void host_extra_task(void);
+bool host_extra_tap_pending(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -53,6 +53,7 @@
 #include "lufa.h"
 #include "quantum.h"
 #include "usb_device_state.h"
+#include "task_profiler.h"
 #include <util/atomic.h>
 
 #ifdef NKRO_ENABLE
@@ -576,6 +577,7 @@ static void send_keyboard(report_keyboard_t *report) {
 
         send_report(ep, report, size);
     }
+    task_profiler_report_sent();
 
     keyboard_report_sent = *report;
 }
@@ -5,6 +5,8 @@ VUSB_PATH = $(LIB_PATH)/vusb
 
 SRC += $(VUSB_DIR)/protocol.c \
 	$(VUSB_DIR)/vusb.c \
+	$(VUSB_DIR)/shared_ep.c \
+	$(VUSB_DIR)/kbuf.c \
 	$(VUSB_DIR)/usb_util.c \
 	$(VUSB_PATH)/usbdrv/usbdrv.c \
 	$(VUSB_PATH)/usbdrv/usbdrvasm.S \
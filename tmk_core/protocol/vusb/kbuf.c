@@ -0,0 +1,55 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "kbuf.h"
+
+static bool kbuf_has_key(const report_keyboard_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool kbuf_can_coalesce(const report_keyboard_t *prev, const report_keyboard_t *last, const report_keyboard_t *next) {
+    if ((prev->mods ^ last->mods) & (last->mods ^ next->mods)) {
+        return false;
+    }
+
+    bool    released     = prev->mods & ~next->mods;
+    bool    mods_pressed = ~prev->mods & next->mods;
+    bool    last_pressed = false;
+    uint8_t keys_pressed = 0;
+
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = last->keys[i];
+        if (key && !kbuf_has_key(prev, key)) {
+            if (!kbuf_has_key(next, key)) {
+                // pressed and released again
+                return false;
+            }
+            last_pressed = true;
+        }
+        key = prev->keys[i];
+        if (key && !kbuf_has_key(next, key)) {
+            released = true;
+        } else if (key && !kbuf_has_key(last, key)) {
+            // released and pressed again
+            return false;
+        }
+        key = next->keys[i];
+        if (key && !kbuf_has_key(prev, key)) {
+            keys_pressed++;
+        }
+    }
+
+    if (last_pressed && (~last->mods & next->mods)) {
+        // the key was pressed without these modifiers
+        return false;
+    }
+    if (released) {
+        return !mods_pressed && !keys_pressed;
+    }
+    return keys_pressed <= 1;
+}
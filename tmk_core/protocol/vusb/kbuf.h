@@ -0,0 +1,21 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include "report.h"
+
+/**
+ * @brief Whether the keyboard report after last can replace it in the send buffer.
+ *
+ * Going from prev straight to next, skipping last, must lose nothing for the host: no
+ * key changes twice, and the changes left are either all releases or presses of at most
+ * one key along with any modifiers, which a single report already orders. Modifiers
+ * pressed in next are only merged when last pressed no key, the host would otherwise
+ * see that key with them.
+ *
+ * @param prev[in] the report before last
+ * @param last[in] the last queued report
+ * @param next[in] the new report
+ */
+bool kbuf_can_coalesce(const report_keyboard_t *prev, const report_keyboard_t *last, const report_keyboard_t *next);
@@ -18,6 +18,7 @@
 #include <usbdrv/usbdrv.h>
 
 #include "vusb.h"
+#include "shared_ep.h"
 
 #include "keyboard.h"
 #include "host.h"
@@ -154,6 +155,7 @@ void protocol_task(void) {
             keyboard_task();
         }
         vusb_transfer_keyboard();
+        shared_ep_task();
 
 #ifdef RAW_ENABLE
         usbPoll();
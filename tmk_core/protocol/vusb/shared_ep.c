@@ -0,0 +1,146 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "shared_ep.h"
+#include "report.h"
+
+#if defined(MOUSE_ENABLE) || defined(EXTRAKEY_ENABLE) || defined(JOYSTICK_ENABLE) || defined(DIGITIZER_ENABLE) || defined(PROGRAMMABLE_BUTTON_ENABLE)
+
+#    ifdef MOUSE_ENABLE
+static report_mouse_t mouse_queue[SHARED_EP_QUEUE_SIZE];
+#    endif
+#    ifdef EXTRAKEY_ENABLE
+static report_extra_t extra_queue[SHARED_EP_QUEUE_SIZE];
+#    endif
+#    ifdef JOYSTICK_ENABLE
+static report_joystick_t joystick_queue[SHARED_EP_QUEUE_SIZE];
+#    endif
+#    ifdef DIGITIZER_ENABLE
+static report_digitizer_t digitizer_queue[SHARED_EP_QUEUE_SIZE];
+#    endif
+#    ifdef PROGRAMMABLE_BUTTON_ENABLE
+static report_programmable_button_t programmable_button_queue[SHARED_EP_QUEUE_SIZE];
+#    endif
+
+typedef struct {
+    void   *reports; // SHARED_EP_QUEUE_SIZE reports of size bytes
+    uint8_t size;
+} shared_ep_queue_t;
+
+static const shared_ep_queue_t shared_ep_queues[SHARED_EP_REPORT_COUNT] = {
+#    ifdef MOUSE_ENABLE
+    [SHARED_EP_MOUSE] = {mouse_queue, sizeof(report_mouse_t)},
+#    endif
+#    ifdef EXTRAKEY_ENABLE
+    [SHARED_EP_EXTRA] = {extra_queue, sizeof(report_extra_t)},
+#    endif
+#    ifdef JOYSTICK_ENABLE
+    [SHARED_EP_JOYSTICK] = {joystick_queue, sizeof(report_joystick_t)},
+#    endif
+#    ifdef DIGITIZER_ENABLE
+    [SHARED_EP_DIGITIZER] = {digitizer_queue, sizeof(report_digitizer_t)},
+#    endif
+#    ifdef PROGRAMMABLE_BUTTON_ENABLE
+    [SHARED_EP_PROGRAMMABLE_BUTTON] = {programmable_button_queue, sizeof(report_programmable_button_t)},
+#    endif
+};
+
+static uint8_t shared_ep_head[SHARED_EP_REPORT_COUNT];
+static uint8_t shared_ep_count[SHARED_EP_REPORT_COUNT];
+static uint8_t shared_ep_next  = 0;
+static uint8_t shared_ep_total = 0;
+
+static uint8_t *shared_ep_slot(shared_ep_report_t type, uint8_t index) {
+    const shared_ep_queue_t *queue = &shared_ep_queues[type];
+    return (uint8_t *)queue->reports + (index % SHARED_EP_QUEUE_SIZE) * queue->size;
+}
+
+#    ifdef MOUSE_ENABLE
+#        ifdef MOUSE_EXTENDED_REPORT
+#            define MOUSE_XY_MAX INT16_MAX
+#        else
+#            define MOUSE_XY_MAX 127
+#        endif
+
+static bool mouse_add(int16_t *sum, int16_t value, int16_t max) {
+    int32_t added = (int32_t)*sum + value;
+    if (added > max || added < -max) {
+        return false;
+    }
+    *sum = added;
+    return true;
+}
+
+/* Adds the movement of report to last, if that keeps every axis in range */
+static bool mouse_merge(report_mouse_t *last, const report_mouse_t *report) {
+    int16_t x = last->x, y = last->y, v = last->v, h = last->h;
+
+    if (last->buttons != report->buttons || !mouse_add(&x, report->x, MOUSE_XY_MAX) || !mouse_add(&y, report->y, MOUSE_XY_MAX) || !mouse_add(&v, report->v, 127) || !mouse_add(&h, report->h, 127)) {
+        return false;
+    }
+
+    last->x = x;
+    last->y = y;
+    last->v = v;
+    last->h = h;
+#        ifdef MOUSE_EXTENDED_REPORT
+    last->boot_x = (x > 127) ? 127 : ((x < -127) ? -127 : x);
+    last->boot_y = (y > 127) ? 127 : ((y < -127) ? -127 : y);
+#        endif
+    return true;
+}
+#    endif
+
+bool shared_ep_queue(shared_ep_report_t type, const void *report) {
+    uint8_t count = shared_ep_count[type];
+
+#    ifdef MOUSE_ENABLE
+    if (type == SHARED_EP_MOUSE && count > 0) {
+        report_mouse_t *last = (report_mouse_t *)shared_ep_slot(type, shared_ep_head[type] + count - 1);
+        if (mouse_merge(last, report)) {
+            return true;
+        }
+    }
+#    endif
+
+    if (count == SHARED_EP_QUEUE_SIZE) {
+        return false;
+    }
+    memcpy(shared_ep_slot(type, shared_ep_head[type] + count), report, shared_ep_queues[type].size);
+    shared_ep_count[type]++;
+    shared_ep_total++;
+    return true;
+}
+
+void shared_ep_task(void) {
+    if (shared_ep_total == 0 || !shared_ep_ready()) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < SHARED_EP_REPORT_COUNT; i++) {
+        uint8_t type = (shared_ep_next + i) % SHARED_EP_REPORT_COUNT;
+        if (shared_ep_count[type] == 0) {
+            continue;
+        }
+
+        shared_ep_write(shared_ep_slot(type, shared_ep_head[type]), shared_ep_queues[type].size);
+        shared_ep_head[type] = (shared_ep_head[type] + 1) % SHARED_EP_QUEUE_SIZE;
+        shared_ep_count[type]--;
+        shared_ep_total--;
+        shared_ep_next = (type + 1) % SHARED_EP_REPORT_COUNT;
+        return;
+    }
+}
+
+uint8_t shared_ep_pending(void) {
+    return shared_ep_total;
+}
+
+#else
+void shared_ep_task(void) {}
+
+uint8_t shared_ep_pending(void) {
+    return 0;
+}
+#endif
@@ -0,0 +1,61 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Schedules the reports sharing the interrupt endpoint of the shared interface.
+
+    Every report type queues up to SHARED_EP_QUEUE_SIZE reports. Whenever the endpoint is
+    free, shared_ep_task() sends the oldest report of the next type that has one waiting,
+    round robin, so a report waits at most for one report of every other type in front of
+    it. A mouse report with the same buttons as the last queued one is added to it.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SHARED_EP_QUEUE_SIZE
+#    define SHARED_EP_QUEUE_SIZE 4
+#endif
+
+typedef enum {
+#ifdef MOUSE_ENABLE
+    SHARED_EP_MOUSE,
+#endif
+#ifdef EXTRAKEY_ENABLE
+    SHARED_EP_EXTRA,
+#endif
+#ifdef JOYSTICK_ENABLE
+    SHARED_EP_JOYSTICK,
+#endif
+#ifdef DIGITIZER_ENABLE
+    SHARED_EP_DIGITIZER,
+#endif
+#ifdef PROGRAMMABLE_BUTTON_ENABLE
+    SHARED_EP_PROGRAMMABLE_BUTTON,
+#endif
+    SHARED_EP_REPORT_COUNT
+} shared_ep_report_t;
+
+/**
+ * @brief Queues a report to be sent by shared_ep_task().
+ *
+ * @param type[in] the type of the report, which sets its size
+ * @param report[in] the report, copied
+ * @return false if the queue of this type is full
+ */
+bool shared_ep_queue(shared_ep_report_t type, const void *report);
+
+/**
+ * @brief Sends the next queued report if the endpoint is free, run by the main loop.
+ */
+void shared_ep_task(void);
+
+/**
+ * @brief Number of reports waiting, of all types.
+ */
+uint8_t shared_ep_pending(void);
+
+/* Provided by the protocol */
+bool shared_ep_ready(void);
+void shared_ep_write(const void *report, uint8_t size);
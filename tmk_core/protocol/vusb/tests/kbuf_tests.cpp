@@ -0,0 +1,55 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "report.h"
+#include "kbuf.h"
+}
+
+static report_keyboard_t report(uint8_t mods, uint8_t key = 0, uint8_t key2 = 0) {
+    report_keyboard_t report = {};
+    report.mods              = mods;
+    report.keys[0]           = key;
+    report.keys[1]           = key2;
+    return report;
+}
+
+static bool can_coalesce(report_keyboard_t prev, report_keyboard_t last, report_keyboard_t next) {
+    return kbuf_can_coalesce(&prev, &last, &next);
+}
+
+#define SHIFT MOD_BIT(KC_LEFT_SHIFT)
+#define CTRL MOD_BIT(KC_LEFT_CTRL)
+
+TEST(VusbKbuf, KeyThenModifier) {
+    // {a} then {Shift, a} would type "A"
+    EXPECT_FALSE(can_coalesce(report(0), report(0, KC_A), report(SHIFT, KC_A)));
+    EXPECT_FALSE(can_coalesce(report(CTRL), report(CTRL, KC_A), report(CTRL | SHIFT, KC_A)));
+}
+
+TEST(VusbKbuf, ModifierThenKey) {
+    EXPECT_TRUE(can_coalesce(report(0), report(SHIFT), report(SHIFT, KC_A)));
+    EXPECT_TRUE(can_coalesce(report(0), report(SHIFT), report(SHIFT | CTRL, KC_A)));
+    EXPECT_TRUE(can_coalesce(report(SHIFT, KC_A), report(SHIFT | CTRL, KC_A), report(SHIFT | CTRL, KC_A, KC_B)));
+}
+
+TEST(VusbKbuf, PressThenRelease) {
+    EXPECT_FALSE(can_coalesce(report(0), report(0, KC_A), report(0)));
+    EXPECT_FALSE(can_coalesce(report(0), report(SHIFT), report(0)));
+    EXPECT_FALSE(can_coalesce(report(0, KC_A), report(0, KC_A, KC_B), report(0, KC_A)));
+}
+
+TEST(VusbKbuf, ReleaseThenPress) {
+    EXPECT_FALSE(can_coalesce(report(0, KC_A), report(0), report(0, KC_A)));
+    EXPECT_FALSE(can_coalesce(report(SHIFT), report(0), report(SHIFT)));
+    // releasing a before pressing b is not the same as a single report doing both
+    EXPECT_FALSE(can_coalesce(report(0, KC_A), report(0), report(0, KC_B)));
+}
+
+TEST(VusbKbuf, ReleasesAndSinglePress) {
+    EXPECT_TRUE(can_coalesce(report(SHIFT, KC_A, KC_B), report(SHIFT, KC_B), report(0)));
+    EXPECT_TRUE(can_coalesce(report(0), report(0), report(0, KC_A)));
+    EXPECT_FALSE(can_coalesce(report(0), report(0, KC_A), report(0, KC_A, KC_B)));
+}
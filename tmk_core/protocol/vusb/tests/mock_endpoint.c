@@ -0,0 +1,35 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "mock_endpoint.h"
+#include "shared_ep.h"
+
+bool    endpoint_busy = false;
+uint8_t endpoint_sent[MOCK_ENDPOINT_SENT_MAX][8];
+uint8_t endpoint_sent_count = 0;
+
+void mock_endpoint_reset(void) {
+    while (shared_ep_pending()) {
+        mock_endpoint_poll();
+        shared_ep_task();
+    }
+    endpoint_busy       = false;
+    endpoint_sent_count = 0;
+    memset(endpoint_sent, 0, sizeof(endpoint_sent));
+}
+
+void mock_endpoint_poll(void) {
+    endpoint_busy = false;
+}
+
+bool shared_ep_ready(void) {
+    return !endpoint_busy;
+}
+
+void shared_ep_write(const void *report, uint8_t size) {
+    if (endpoint_sent_count < MOCK_ENDPOINT_SENT_MAX) {
+        memcpy(endpoint_sent[endpoint_sent_count++], report, size < 8 ? size : 8);
+    }
+    endpoint_busy = true;
+}
@@ -0,0 +1,16 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MOCK_ENDPOINT_SENT_MAX 64
+
+/* The endpoint takes one report and is busy until the host polls it */
+extern bool    endpoint_busy;
+extern uint8_t endpoint_sent[MOCK_ENDPOINT_SENT_MAX][8];
+extern uint8_t endpoint_sent_count;
+
+void mock_endpoint_reset(void);
+void mock_endpoint_poll(void);
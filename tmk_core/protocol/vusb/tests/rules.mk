@@ -0,0 +1,13 @@
+vusb_shared_ep_DEFS := -DMOUSE_ENABLE -DMOUSE_SHARED_EP -DEXTRAKEY_ENABLE -DPROGRAMMABLE_BUTTON_ENABLE
+vusb_shared_ep_INC := $(PROTOCOL_PATH)/vusb
+
+vusb_shared_ep_SRC := \
+	$(PROTOCOL_PATH)/vusb/tests/mock_endpoint.c \
+	$(PROTOCOL_PATH)/vusb/tests/shared_ep_tests.cpp \
+	$(PROTOCOL_PATH)/vusb/shared_ep.c
+
+vusb_kbuf_INC := $(PROTOCOL_PATH)/vusb
+
+vusb_kbuf_SRC := \
+	$(PROTOCOL_PATH)/vusb/tests/kbuf_tests.cpp \
+	$(PROTOCOL_PATH)/vusb/kbuf.c
@@ -0,0 +1,152 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <map>
+
+extern "C" {
+#include "report.h"
+#include "shared_ep.h"
+#include "mock_endpoint.h"
+}
+
+class SharedEndpointTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_endpoint_reset();
+    }
+
+    // The host polls the endpoint and the main loop runs, sent reports are returned
+    uint8_t host_polls(uint8_t polls) {
+        for (uint8_t i = 0; i < polls; i++) {
+            mock_endpoint_poll();
+            shared_ep_task();
+        }
+        return endpoint_sent_count;
+    }
+};
+
+static void queue_mouse(uint8_t buttons, int8_t x) {
+    report_mouse_t report = {.report_id = REPORT_ID_MOUSE, .buttons = buttons, .x = x};
+    EXPECT_TRUE(shared_ep_queue(SHARED_EP_MOUSE, &report));
+}
+
+static bool queue_consumer(uint16_t usage) {
+    report_extra_t report = {.report_id = REPORT_ID_CONSUMER, .usage = usage};
+    return shared_ep_queue(SHARED_EP_EXTRA, &report);
+}
+
+static void queue_programmable_button(uint32_t usage) {
+    report_programmable_button_t report = {.report_id = REPORT_ID_PROGRAMMABLE_BUTTON, .usage = usage};
+    EXPECT_TRUE(shared_ep_queue(SHARED_EP_PROGRAMMABLE_BUTTON, &report));
+}
+
+static uint16_t sent_usage(uint8_t index) {
+    report_extra_t report;
+    memcpy(&report, endpoint_sent[index], sizeof(report));
+    return report.usage;
+}
+
+static report_mouse_t sent_mouse(uint8_t index) {
+    report_mouse_t report;
+    memcpy(&report, endpoint_sent[index], sizeof(report));
+    return report;
+}
+
+TEST_F(SharedEndpointTest, SendsRightAwayWhenFree) {
+    EXPECT_TRUE(queue_consumer(0xE9));
+    shared_ep_task();
+    EXPECT_EQ(endpoint_sent_count, 1);
+    EXPECT_EQ(sent_usage(0), 0xE9);
+    EXPECT_EQ(shared_ep_pending(), 0);
+}
+
+TEST_F(SharedEndpointTest, WaitsForTheHost) {
+    endpoint_busy = true;
+    EXPECT_TRUE(queue_consumer(0xE9));
+    shared_ep_task();
+    EXPECT_EQ(endpoint_sent_count, 0);
+    EXPECT_EQ(host_polls(1), 1);
+}
+
+TEST_F(SharedEndpointTest, ConsumerTapsInOnePollWindowAreKept) {
+    endpoint_busy = true;
+    for (uint8_t i = 0; i < SHARED_EP_QUEUE_SIZE / 2; i++) {
+        EXPECT_TRUE(queue_consumer(0xE9));
+        EXPECT_TRUE(queue_consumer(0));
+    }
+    EXPECT_FALSE(queue_consumer(0xE9));
+
+    ASSERT_EQ(host_polls(SHARED_EP_QUEUE_SIZE), SHARED_EP_QUEUE_SIZE);
+    for (uint8_t i = 0; i < SHARED_EP_QUEUE_SIZE; i++) {
+        EXPECT_EQ(sent_usage(i), (i % 2) ? 0 : 0xE9);
+    }
+}
+
+TEST_F(SharedEndpointTest, TypesTakeTurns) {
+    endpoint_busy = true;
+    for (uint8_t i = 0; i < SHARED_EP_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(queue_consumer(i + 1));
+    }
+    queue_mouse(1, 1);
+    queue_mouse(0, 1);
+    queue_programmable_button(1);
+
+    ASSERT_EQ(host_polls(SHARED_EP_QUEUE_SIZE + 3), SHARED_EP_QUEUE_SIZE + 3);
+
+    // a type never goes twice in a row while another has reports waiting
+    std::map<uint8_t, uint8_t> waiting = {{REPORT_ID_MOUSE, 2}, {REPORT_ID_CONSUMER, SHARED_EP_QUEUE_SIZE}, {REPORT_ID_PROGRAMMABLE_BUTTON, 1}};
+    for (uint8_t i = 0; i < endpoint_sent_count; i++) {
+        uint8_t id = endpoint_sent[i][0];
+        if (i > 0 && id == endpoint_sent[i - 1][0]) {
+            for (auto &other : waiting) {
+                EXPECT_TRUE(other.first == id || other.second == 0) << "report " << +i;
+            }
+        }
+        waiting[id]--;
+    }
+
+    // reports of one type stay in order
+    uint16_t usage = 0;
+    for (uint8_t i = 0; i < endpoint_sent_count; i++) {
+        if (endpoint_sent[i][0] == REPORT_ID_CONSUMER) {
+            EXPECT_EQ(sent_usage(i), ++usage);
+        }
+    }
+}
+
+TEST_F(SharedEndpointTest, LatencyIsBoundedByTheOtherTypes) {
+    endpoint_busy = true;
+    for (uint8_t i = 0; i < SHARED_EP_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(queue_consumer(i + 1));
+        queue_programmable_button(i + 1);
+    }
+    host_polls(3);
+
+    // with the other queues full, a new report goes out within one round
+    queue_mouse(0, 1);
+    uint8_t polls = 0;
+    while (endpoint_sent[endpoint_sent_count - 1][0] != REPORT_ID_MOUSE) {
+        ASSERT_LT(polls, SHARED_EP_REPORT_COUNT);
+        host_polls(1);
+        polls++;
+    }
+}
+
+TEST_F(SharedEndpointTest, MouseMovementIsAdded) {
+    endpoint_busy = true;
+    queue_mouse(0, 10);
+    queue_mouse(0, 5);
+    EXPECT_EQ(shared_ep_pending(), 1);
+
+    // a button change, or movement out of range, needs its own report
+    queue_mouse(1, 5);
+    queue_mouse(1, 125);
+    EXPECT_EQ(shared_ep_pending(), 3);
+
+    ASSERT_EQ(host_polls(3), 3);
+    EXPECT_EQ(sent_mouse(0).x, 15);
+    EXPECT_EQ(sent_mouse(1).buttons, 1);
+    EXPECT_EQ(sent_mouse(1).x, 5);
+    EXPECT_EQ(sent_mouse(2).x, 125);
+}
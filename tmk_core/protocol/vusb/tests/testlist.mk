@@ -0,0 +1,2 @@
+TEST_LIST += vusb_shared_ep
+TEST_LIST += vusb_kbuf
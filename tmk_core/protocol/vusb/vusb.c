@@ -26,10 +26,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "report.h"
 #include "host_driver.h"
 #include "vusb.h"
+#include "shared_ep.h"
+#include "kbuf.h"
 #include "print.h"
 #include "debug.h"
 #include "wait.h"
 #include "usb_descriptor_common.h"
+#include "task_profiler.h"
 
 #ifdef RAW_ENABLE
 #    include "raw_hid.h"
@@ -92,43 +95,66 @@ enum usb_interfaces {
 static uint8_t keyboard_led_state = 0;
 static uint8_t vusb_idle_rate     = 0;
 
-/* Keyboard report send buffer */
+/* Keyboard report send buffer
+ *
+ * The slot before kbuf_tail always holds the last report handed to the host, the slot
+ * before kbuf_head the last one queued. A new report replaces the last queued one when
+ * the host would see the same key changes in the same order, see kbuf_can_coalesce().
+ */
 #define KBUF_SIZE 16
 static report_keyboard_t kbuf[KBUF_SIZE];
 static uint8_t           kbuf_head = 0;
 static uint8_t           kbuf_tail = 0;
+#if defined(TASK_PROFILER_ENABLE) && defined(TASK_PROFILER_LATENCY)
+// task_profiler_report_seq() of the report in each slot
+static uint8_t kbuf_seq[KBUF_SIZE];
+#    define KBUF_SET_SEQ(i) kbuf_seq[i] = task_profiler_report_seq()
+#    define KBUF_SENT(i) task_profiler_report_sent_seq(kbuf_seq[i])
+#else
+#    define KBUF_SET_SEQ(i)
+#    define KBUF_SENT(i)
+#endif
 
-static report_keyboard_t keyboard_report_sent;
+static report_keyboard_t     keyboard_report_sent;
+static vusb_keyboard_stats_t kbuf_stats;
 
 #define VUSB_TRANSFER_KEYBOARD_MAX_TRIES 10
 
-/* transfer keyboard report from buffer */
+#define KBUF_PREV(i) (((i) + KBUF_SIZE - 1) % KBUF_SIZE)
+#define KBUF_COUNT(counter)         \
+    do {                            \
+        if (counter < UINT16_MAX) { \
+            counter++;              \
+        }                           \
+    } while (0)
+
+/* transfer keyboard report from buffer, one report per call without waiting */
 void vusb_transfer_keyboard(void) {
-    for (int i = 0; i < VUSB_TRANSFER_KEYBOARD_MAX_TRIES; i++) {
-        if (usbInterruptIsReady()) {
-            if (kbuf_head != kbuf_tail) {
+    if (usbInterruptIsReady()) {
+        if (kbuf_head != kbuf_tail) {
 #ifndef KEYBOARD_SHARED_EP
-                usbSetInterrupt((void *)&kbuf[kbuf_tail], sizeof(report_keyboard_t));
+            usbSetInterrupt((void *)&kbuf[kbuf_tail], sizeof(report_keyboard_t));
 #else
-                // Ugly hack! :(
-                usbSetInterrupt((void *)&kbuf[kbuf_tail], sizeof(report_keyboard_t) - 1);
-                while (!usbInterruptIsReady()) {
-                    usbPoll();
-                }
-                usbSetInterrupt((void *)(&(kbuf[kbuf_tail].keys[5])), 1);
+            // Ugly hack! :(
+            usbSetInterrupt((void *)&kbuf[kbuf_tail], sizeof(report_keyboard_t) - 1);
+            while (!usbInterruptIsReady()) {
+                usbPoll();
+            }
+            usbSetInterrupt((void *)(&(kbuf[kbuf_tail].keys[5])), 1);
 #endif
-                kbuf_tail = (kbuf_tail + 1) % KBUF_SIZE;
-                if (debug_keyboard) {
-                    dprintf("V-USB: kbuf[%d->%d](%02X)\n", kbuf_tail, kbuf_head, (kbuf_head < kbuf_tail) ? (KBUF_SIZE - kbuf_tail + kbuf_head) : (kbuf_head - kbuf_tail));
-                }
+            KBUF_SENT(kbuf_tail);
+            kbuf_tail = (kbuf_tail + 1) % KBUF_SIZE;
+            if (debug_keyboard) {
+                dprintf("V-USB: kbuf[%d->%d](%02X)\n", kbuf_tail, kbuf_head, (kbuf_head < kbuf_tail) ? (KBUF_SIZE - kbuf_tail + kbuf_head) : (kbuf_head - kbuf_tail));
             }
-            break;
         }
-        usbPoll();
-        wait_ms(1);
     }
 }
 
+void vusb_keyboard_stats(vusb_keyboard_stats_t *stats) {
+    *stats = kbuf_stats;
+}
+
 /*------------------------------------------------------------------*
  * RAW HID
  *------------------------------------------------------------------*/
@@ -245,12 +271,33 @@ static uint8_t keyboard_leds(void) {
 }
 
 static void send_keyboard(report_keyboard_t *report) {
+    uint8_t last = KBUF_PREV(kbuf_head);
     uint8_t next = (kbuf_head + 1) % KBUF_SIZE;
-    if (next != kbuf_tail) {
-        kbuf[kbuf_head] = *report;
-        kbuf_head       = next;
+
+    if (kbuf_head != kbuf_tail && kbuf_can_coalesce(&kbuf[KBUF_PREV(last)], &kbuf[last], report)) {
+        kbuf[last] = *report;
+        KBUF_SET_SEQ(last);
+        KBUF_COUNT(kbuf_stats.coalesced);
     } else {
-        dprint("kbuf: full\n");
+        if (next == kbuf_tail) {
+            // wait for the host to take a report, the only case the main loop is held up
+            KBUF_COUNT(kbuf_stats.stalls);
+            for (uint8_t i = 0; i < VUSB_TRANSFER_KEYBOARD_MAX_TRIES && next == kbuf_tail; i++) {
+                usbPoll();
+                vusb_transfer_keyboard();
+                if (next == kbuf_tail) {
+                    wait_ms(1);
+                }
+            }
+        }
+        if (next != kbuf_tail) {
+            kbuf[kbuf_head] = *report;
+            KBUF_SET_SEQ(kbuf_head);
+            kbuf_head = next;
+        } else {
+            KBUF_COUNT(kbuf_stats.dropped);
+            dprint("kbuf: full\n");
+        }
     }
 
     // NOTE: send key strokes of Macro
@@ -267,43 +314,58 @@ static void send_keyboard(report_keyboard_t *report) {
 #    define usbSetInterruptShared usbSetInterrupt
 #endif
 
+bool shared_ep_ready(void) {
+    return usbInterruptIsReadyShared();
+}
+
+void shared_ep_write(const void *report, uint8_t size) {
+    usbSetInterruptShared((void *)report, size);
+}
+
+#if defined(MOUSE_ENABLE) || defined(EXTRAKEY_ENABLE) || defined(JOYSTICK_ENABLE) || defined(DIGITIZER_ENABLE) || defined(PROGRAMMABLE_BUTTON_ENABLE)
+static void send_shared(shared_ep_report_t type, const void *report) {
+    for (uint8_t i = 0; !shared_ep_queue(type, report); i++) {
+        if (i == VUSB_TRANSFER_KEYBOARD_MAX_TRIES) {
+            dprint("shared: full\n");
+            return;
+        }
+        if (i) {
+            wait_ms(1);
+        }
+        usbPoll();
+        shared_ep_task();
+    }
+    shared_ep_task();
+}
+#endif
+
 static void send_mouse(report_mouse_t *report) {
 #ifdef MOUSE_ENABLE
-    if (usbInterruptIsReadyShared()) {
-        usbSetInterruptShared((void *)report, sizeof(report_mouse_t));
-    }
+    send_shared(SHARED_EP_MOUSE, report);
 #endif
 }
 
 static void send_extra(report_extra_t *report) {
 #ifdef EXTRAKEY_ENABLE
-    if (usbInterruptIsReadyShared()) {
-        usbSetInterruptShared((void *)report, sizeof(report_extra_t));
-    }
+    send_shared(SHARED_EP_EXTRA, report);
 #endif
 }
 
 void send_joystick(report_joystick_t *report) {
 #ifdef JOYSTICK_ENABLE
-    if (usbInterruptIsReadyShared()) {
-        usbSetInterruptShared((void *)report, sizeof(report_joystick_t));
-    }
+    send_shared(SHARED_EP_JOYSTICK, report);
 #endif
 }
 
 void send_digitizer(report_digitizer_t *report) {
 #ifdef DIGITIZER_ENABLE
-    if (usbInterruptIsReadyShared()) {
-        usbSetInterruptShared((void *)report, sizeof(report_digitizer_t));
-    }
+    send_shared(SHARED_EP_DIGITIZER, report);
 #endif
 }
 
 void send_programmable_button(report_programmable_button_t *report) {
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-    if (usbInterruptIsReadyShared()) {
-        usbSetInterruptShared((void *)report, sizeof(report_programmable_button_t));
-    }
+    send_shared(SHARED_EP_PROGRAMMABLE_BUTTON, report);
 #endif
 }
 
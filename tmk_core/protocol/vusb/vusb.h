@@ -118,7 +118,15 @@ typedef struct usbConfigurationDescriptor {
 #endif
 } __attribute__((packed)) usbConfigurationDescriptor_t;
 
+/* Counters of the keyboard report queue, saturating at UINT16_MAX */
+typedef struct {
+    uint16_t stalls;    // times send_keyboard() waited for the host on a full queue
+    uint16_t coalesced; // reports merged into the last queued one
+    uint16_t dropped;   // reports lost after waiting
+} vusb_keyboard_stats_t;
+
 extern bool vusb_suspended;
 
 host_driver_t *vusb_driver(void);
 void           vusb_transfer_keyboard(void);
+void           vusb_keyboard_stats(vusb_keyboard_stats_t *stats);